@@ -0,0 +1,203 @@
+#define _POSIX_C_SOURCE 200809L
+#include "bench.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// number of results printed so far, used to separate JSON objects
+static long reported = 0;
+static uint64_t random_state = 0x9E3779B97F4A7C15ull;
+
+static int bench_parse_long(const char *arg, const char *name, long *value) {
+    size_t len = strlen(name);
+    if (strncmp(arg, name, len) != 0 || arg[len] != '=') {
+        return 0;
+    }
+
+    char *end = NULL;
+    long parsed = strtol(arg + len + 1, &end, 10);
+    if (end == arg + len + 1 || *end != '\0' || parsed < 0) {
+        return -1;
+    }
+
+    *value = parsed;
+    return 1;
+}
+
+int bench_parse_args(bench_config_t *config, int argc, char **argv) {
+    config->warmup      = 1;
+    config->repetitions = 11;
+    config->min_size    = 10;
+    config->max_size    = 10000000;
+    config->format      = BENCH_FORMAT_CSV;
+    config->filter      = NULL;
+
+    for (int i = 1; i < argc; ++i) {
+        const char *arg = argv[i];
+        long value = 0;
+        int matched;
+
+        if (strcmp(arg, "--format=csv") == 0) {
+            config->format = BENCH_FORMAT_CSV;
+        } else if (strcmp(arg, "--format=json") == 0) {
+            config->format = BENCH_FORMAT_JSON;
+        } else if (strncmp(arg, "--filter=", 9) == 0) {
+            config->filter = arg + 9;
+        } else if ((matched = bench_parse_long(arg, "--warmup", &value)) != 0) {
+            if (matched < 0) {
+                return 1;
+            }
+            config->warmup = (int) value;
+        } else if ((matched = bench_parse_long(arg, "--repetitions", &value)) != 0) {
+            if (matched < 0 || value == 0) {
+                return 1;
+            }
+            config->repetitions = (int) value;
+        } else if ((matched = bench_parse_long(arg, "--min-size", &value)) != 0) {
+            if (matched < 0) {
+                return 1;
+            }
+            config->min_size = value;
+        } else if ((matched = bench_parse_long(arg, "--max-size", &value)) != 0) {
+            if (matched < 0) {
+                return 1;
+            }
+            config->max_size = value;
+        } else {
+            fprintf(stderr, "unknown option: %s\n", arg);
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+void bench_begin(const bench_config_t *config) {
+    reported = 0;
+    if (config->format == BENCH_FORMAT_JSON) {
+        puts("[");
+    } else {
+        // one schema for every row, throughput rows leave the percentiles
+        // empty and latency rows the per-op columns
+        puts("module,operation,workload,size,ops,repetitions,median_ns_per_op,min_ns_per_op,ops_per_sec,p50_ns,p99_ns,max_ns");
+    }
+}
+
+void bench_end(const bench_config_t *config) {
+    if (config->format == BENCH_FORMAT_JSON) {
+        puts(reported > 0 ? "\n]" : "]");
+    }
+    fflush(stdout);
+}
+
+int bench_enabled(const bench_config_t *config, const char *module,
+                  const char *operation, const char *workload) {
+    if (config->filter == NULL) {
+        return 1;
+    }
+
+    char name[256];
+    snprintf(name, sizeof(name), "%s/%s/%s", module, operation, workload);
+    return strstr(name, config->filter) != NULL;
+}
+
+static int bench_compare(const void *a, const void *b) {
+    double x = *(const double *) a;
+    double y = *(const double *) b;
+    return (x > y) - (x < y);
+}
+
+void bench_run(const bench_config_t *config, const char *module,
+               const char *operation, const char *workload, long size,
+               long ops, bench_fn run, bench_fn restore, void *ctx) {
+    if (!bench_enabled(config, module, operation, workload) || ops < 1) {
+        return;
+    }
+
+    double *samples = (double *) malloc(config->repetitions * sizeof(double));
+    if (samples == NULL) {
+        return;
+    }
+
+    for (int i = -config->warmup; i < config->repetitions; ++i) {
+        uint64_t start = bench_now_ns();
+        run(ctx, ops);
+        uint64_t elapsed = bench_now_ns() - start;
+
+        if (restore != NULL) {
+            restore(ctx, ops);
+        }
+
+        if (i >= 0) {
+            samples[i] = (double) elapsed / ops;
+        }
+    }
+
+    qsort(samples, config->repetitions, sizeof(double), bench_compare);
+    double median = samples[config->repetitions / 2];
+    double min = samples[0];
+    double ops_per_sec = median > 0 ? 1e9 / median : 0;
+
+    if (config->format == BENCH_FORMAT_JSON) {
+        printf("%s  {\"module\": \"%s\", \"operation\": \"%s\", \"workload\": \"%s\", "
+               "\"size\": %ld, \"ops\": %ld, \"repetitions\": %d, "
+               "\"median_ns_per_op\": %.2f, \"min_ns_per_op\": %.2f, \"ops_per_sec\": %.0f}",
+               reported > 0 ? ",\n" : "", module, operation, workload,
+               size, ops, config->repetitions, median, min, ops_per_sec);
+    } else {
+        printf("%s,%s,%s,%ld,%ld,%d,%.2f,%.2f,%.0f,,,\n", module, operation, workload,
+               size, ops, config->repetitions, median, min, ops_per_sec);
+    }
+    fflush(stdout);
+    reported++;
+
+    free(samples);
+}
+
+static int bench_compare_u64(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *) a;
+    uint64_t y = *(const uint64_t *) b;
+    return (x > y) - (x < y);
+}
+
+void bench_latency(const bench_config_t *config, const char *module,
+                   const char *operation, const char *workload, long size,
+                   uint64_t *samples, long count) {
+    if (!bench_enabled(config, module, operation, workload) || count < 1) {
+        return;
+    }
+
+    qsort(samples, count, sizeof(uint64_t), bench_compare_u64);
+    uint64_t p50 = samples[count / 2];
+    uint64_t p99 = samples[(long) (count * 0.99)];
+    uint64_t max = samples[count - 1];
+
+    if (config->format == BENCH_FORMAT_JSON) {
+        printf("%s  {\"module\": \"%s\", \"operation\": \"%s\", \"workload\": \"%s\", "
+               "\"size\": %ld, \"samples\": %ld, "
+               "\"p50_ns\": %llu, \"p99_ns\": %llu, \"max_ns\": %llu}",
+               reported > 0 ? ",\n" : "", module, operation, workload, size, count,
+               (unsigned long long) p50, (unsigned long long) p99, (unsigned long long) max);
+    } else {
+        // the samples fill the ops column
+        printf("%s,%s,%s,%ld,%ld,,,,,%llu,%llu,%llu\n", module, operation, workload, size, count,
+               (unsigned long long) p50, (unsigned long long) p99, (unsigned long long) max);
+    }
+    fflush(stdout);
+    reported++;
+}
+
+uint64_t bench_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ull + (uint64_t) ts.tv_nsec;
+}
+
+long bench_random(long bound) {
+    // xorshift64*
+    random_state ^= random_state >> 12;
+    random_state ^= random_state << 25;
+    random_state ^= random_state >> 27;
+    return (long) ((random_state * 2685821657736338717ull) % (uint64_t) bound);
+}
@@ -0,0 +1,123 @@
+/**
+ * @file bench.h
+ * @brief A small benchmark harness shared by the benchmark programs.
+ * @note Each measurement runs a batch of operations a number of times after
+ * some warmup runs. Only the batch itself is timed, an optional restore
+ * callback runs untimed afterwards to bring the structure back to its
+ * original size. Results are reported as CSV or JSON on stdout with the
+ * median and minimum ns/op and the median ops/sec. Latency distributions
+ * collected by the program itself are reported as percentiles. CSV rows
+ * share one header, throughput rows leave the percentile columns empty and
+ * latency rows the per-op columns.
+ */
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <stdint.h>
+
+/**
+ * @brief The output format of the results.
+ */
+typedef enum BenchFormat {
+    BENCH_FORMAT_CSV, /**< One comma separated line per result. */
+    BENCH_FORMAT_JSON /**< A JSON array of result objects. */
+} bench_format_t;
+
+/**
+ * @brief Settings shared by all measurements of a benchmark program.
+ */
+typedef struct BenchConfig {
+    int warmup; /**< Untimed runs before measuring. */
+    int repetitions; /**< Timed runs, the median is reported. */
+    long min_size; /**< Smallest structure size to measure. */
+    long max_size; /**< Largest structure size to measure. */
+    bench_format_t format; /**< Output format. */
+    const char *filter; /**< Only run benchmarks whose name contains this, or NULL. */
+} bench_config_t;
+
+/**
+ * @brief Runs a batch of operations on a benchmark context.
+ * @param ctx The benchmark context.
+ * @param ops The number of operations in the batch.
+ */
+typedef void (*bench_fn)(void *ctx, long ops);
+
+/**
+ * @brief Parses the common command line options.
+ *
+ * Recognized options are `--format=csv|json`, `--warmup=N`,
+ * `--repetitions=N`, `--min-size=N`, `--max-size=N` and `--filter=TEXT`.
+ * @param config A pointer to the config, filled with defaults first.
+ * @param argc The argument count.
+ * @param argv The argument vector.
+ * @return 0 on success, 1 on an unknown or malformed option.
+ */
+int bench_parse_args(bench_config_t *config, int argc, char **argv);
+
+/**
+ * @brief Prints the header of the result table.
+ * @param config A pointer to the config.
+ */
+void bench_begin(const bench_config_t *config);
+
+/**
+ * @brief Prints the footer of the result table.
+ * @param config A pointer to the config.
+ */
+void bench_end(const bench_config_t *config);
+
+/**
+ * @brief Checks whether a benchmark passes the configured filter.
+ * @param config A pointer to the config.
+ * @param module The module name, e.g. "sll".
+ * @param operation The operation name, e.g. "sll_add_head_node".
+ * @param workload The workload name, e.g. "head".
+ * @return 1 if the benchmark should run, 0 otherwise.
+ */
+int bench_enabled(const bench_config_t *config, const char *module,
+                  const char *operation, const char *workload);
+
+/**
+ * @brief Measures a batch of operations and reports the result.
+ * @param config A pointer to the config.
+ * @param module The module name.
+ * @param operation The operation name.
+ * @param workload The workload name.
+ * @param size The size of the structure the operations run on.
+ * @param ops The number of operations per batch.
+ * @param run Runs the timed batch.
+ * @param restore Undoes the batch untimed, or NULL.
+ * @param ctx The benchmark context passed to both callbacks.
+ */
+void bench_run(const bench_config_t *config, const char *module,
+               const char *operation, const char *workload, long size,
+               long ops, bench_fn run, bench_fn restore, void *ctx);
+
+/**
+ * @brief Reports the p50, p99 and maximum of a set of latency samples.
+ * @param config A pointer to the config.
+ * @param module The module name.
+ * @param operation The operation name.
+ * @param workload The workload name.
+ * @param size The size of the structure the samples were taken on.
+ * @param samples The latencies in nanoseconds, sorted in place.
+ * @param count The number of samples.
+ */
+void bench_latency(const bench_config_t *config, const char *module,
+                   const char *operation, const char *workload, long size,
+                   uint64_t *samples, long count);
+
+/**
+ * @brief Gets a monotonic timestamp.
+ * @return The current time in nanoseconds.
+ */
+uint64_t bench_now_ns(void);
+
+/**
+ * @brief Gets a pseudo random number from a fixed seed sequence.
+ * @param bound The exclusive upper bound, must be positive.
+ * @return A number in [0, bound).
+ */
+long bench_random(long bound);
+
+#endif // BENCH_H
@@ -0,0 +1,141 @@
+/*
+ * Benchmarks for the block deque against using the doubly linked list as a
+ * deque through its begin and end functions, across deque sizes.
+ *
+ * usage: bdq_bench [--format=csv|json] [--min-size=N] [--max-size=N]
+ *                  [--warmup=N] [--repetitions=N] [--filter=TEXT]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "blockdeque.h"
+#include "../doublylinkedlist/doublylinkedlist.h"
+#include "../bench/bench.h"
+
+#define LINEAR_BUDGET (1L << 22)
+#define CONSTANT_BATCH 1000L
+
+typedef struct {
+    bdq_t *bdq;
+    dll_t *dll;
+    long size;
+    int positions[CONSTANT_BATCH];
+    volatile intptr_t sink;
+} bdq_bench_t;
+
+typedef struct {
+    const char *operation;
+    const char *workload;
+    void (*run)(void *ctx, long ops);
+    int linear; // O(n) per op, so the batch shrinks with the size
+} bdq_case_t;
+
+static void *value(long i) {
+    return (void *)(intptr_t)(i + 1);
+}
+
+// each op pushes one element and pops one, leaving the size unchanged
+static void run_bdq_queue(void *ctx, long ops) {
+    bdq_bench_t *b = ctx;
+    for (long i = 0; i < ops; ++i) {
+        bdq_push_back(b->bdq, value(i));
+        bdq_pop_front(b->bdq);
+    }
+}
+
+static void run_bdq_front(void *ctx, long ops) {
+    bdq_bench_t *b = ctx;
+    for (long i = 0; i < ops; ++i) {
+        bdq_push_front(b->bdq, value(i));
+        bdq_pop_front(b->bdq);
+    }
+}
+
+static void run_bdq_back(void *ctx, long ops) {
+    bdq_bench_t *b = ctx;
+    for (long i = 0; i < ops; ++i) {
+        bdq_push_back(b->bdq, value(i));
+        bdq_pop_back(b->bdq);
+    }
+}
+
+static void run_bdq_get(void *ctx, long ops) {
+    bdq_bench_t *b = ctx;
+    for (long i = 0; i < ops; ++i) {
+        b->sink += (intptr_t) bdq_get(b->bdq, b->positions[i]);
+    }
+}
+
+static void run_dll_queue(void *ctx, long ops) {
+    bdq_bench_t *b = ctx;
+    for (long i = 0; i < ops; ++i) {
+        dll_add_end_node(value(i), b->dll);
+        dll_delete_begin_node(b->dll);
+    }
+}
+
+static void run_dll_front(void *ctx, long ops) {
+    bdq_bench_t *b = ctx;
+    for (long i = 0; i < ops; ++i) {
+        dll_add_begin_node(value(i), b->dll);
+        dll_delete_begin_node(b->dll);
+    }
+}
+
+static void run_dll_back(void *ctx, long ops) {
+    bdq_bench_t *b = ctx;
+    for (long i = 0; i < ops; ++i) {
+        dll_add_end_node(value(i), b->dll);
+        dll_delete_end_node(b->dll);
+    }
+}
+
+static const bdq_case_t cases[] = {
+    { "bdq_push_back+bdq_pop_front",              "queue",  run_bdq_queue, 0 },
+    { "dll_add_end_node+dll_delete_begin_node",   "queue",  run_dll_queue, 0 },
+    { "bdq_push_front+bdq_pop_front",             "front",  run_bdq_front, 0 },
+    { "dll_add_begin_node+dll_delete_begin_node", "front",  run_dll_front, 0 },
+    { "bdq_push_back+bdq_pop_back",               "back",   run_bdq_back,  0 },
+    { "dll_add_end_node+dll_delete_end_node",     "back",   run_dll_back,  0 },
+    { "bdq_get",                                  "random", run_bdq_get,   0 },
+};
+
+int main(int argc, char **argv) {
+    bench_config_t config;
+    if (bench_parse_args(&config, argc, argv) != 0) {
+        return 1;
+    }
+
+    bdq_bench_t b = { 0 };
+    bench_begin(&config);
+
+    for (long size = config.min_size; size <= config.max_size; size *= 10) {
+        b.size = size;
+        b.dll = dll_create_linked_list();
+        b.bdq = bdq_create_deque();
+        if (b.bdq == NULL || b.dll == NULL) {
+            return 1;
+        }
+        for (long i = 0; i < size; ++i) {
+            if (bdq_push_back(b.bdq, value(i)) != 0 || dll_add_begin_node(value(i), b.dll) != 1) {
+                return 1;
+            }
+        }
+        for (long i = 0; i < CONSTANT_BATCH; ++i) {
+            b.positions[i] = (int) bench_random(size);
+        }
+
+        for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); ++i) {
+            const bdq_case_t *c = &cases[i];
+            long ops = c->linear ? LINEAR_BUDGET / size : CONSTANT_BATCH;
+            bench_run(&config, "bdq", c->operation, c->workload, size,
+                      ops > 0 ? ops : 1, c->run, NULL, &b);
+        }
+
+        bdq_destroy_deque(b.bdq);
+        dll_destroy_linked_list(b.dll);
+    }
+
+    bench_end(&config);
+    return 0;
+}
@@ -0,0 +1,182 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <assert.h>
+#include "blockdeque.h"
+
+#define MANY (40 * BDQ_BLOCK_SIZE + 7)
+
+void test_push_and_pop() {
+    printf("Running test_push_and_pop...\n");
+    bdq_t *bdq = bdq_create_deque();
+    assert(bdq != NULL);
+    assert(bdq_get_length(bdq) == 0);
+
+    // Pop from empty
+    assert(bdq_pop_front(bdq) == NULL);
+    assert(bdq_pop_back(bdq) == NULL);
+
+    assert(bdq_push_back(bdq, (void *)2) == 0);
+    assert(bdq_push_front(bdq, (void *)1) == 0);
+    assert(bdq_push_back(bdq, (void *)3) == 0);
+    assert(bdq_get_length(bdq) == 3);
+
+    assert(bdq_pop_front(bdq) == (void *)1);
+    assert(bdq_pop_back(bdq) == (void *)3);
+    assert(bdq_pop_back(bdq) == (void *)2);
+    assert(bdq_pop_front(bdq) == NULL);
+    assert(bdq_get_length(bdq) == 0);
+
+    bdq_destroy_deque(bdq);
+    printf("Passed.\n");
+}
+
+void test_many_blocks() {
+    printf("Running test_many_blocks...\n");
+    bdq_t *bdq = bdq_create_deque();
+
+    // Growing at the front first makes the map wrap around
+    for (intptr_t i = MANY; i >= 1; --i) {
+        assert(bdq_push_front(bdq, (void *)i) == 0);
+    }
+    for (intptr_t i = MANY + 1; i <= 2 * MANY; ++i) {
+        assert(bdq_push_back(bdq, (void *)i) == 0);
+    }
+    assert(bdq_get_length(bdq) == 2 * MANY);
+
+    // FIFO from the front, LIFO from the back
+    for (intptr_t i = 1; i <= MANY / 2; ++i) {
+        assert(bdq_pop_front(bdq) == (void *)i);
+    }
+    for (intptr_t i = 2 * MANY; i > MANY; --i) {
+        assert(bdq_pop_back(bdq) == (void *)i);
+    }
+    assert(bdq_get_length(bdq) == MANY - MANY / 2);
+    assert(bdq_get_blocks(bdq) <= (MANY - MANY / 2) / BDQ_BLOCK_SIZE + 3);
+
+    bdq_destroy_deque(bdq);
+    printf("Passed.\n");
+}
+
+void test_indexing() {
+    printf("Running test_indexing...\n");
+    bdq_t *bdq = bdq_create_deque();
+
+    for (intptr_t i = 0; i < MANY; ++i) {
+        assert(bdq_push_back(bdq, (void *)(i + 1)) == 0);
+    }
+    // Shift the front into the middle of a block
+    for (int i = 0; i < 3; ++i) {
+        bdq_pop_front(bdq);
+    }
+
+    int length = bdq_get_length(bdq);
+    for (intptr_t i = 0; i < length; ++i) {
+        assert(bdq_get(bdq, (int) i) == (void *)(i + 4));
+    }
+    assert(bdq_set(bdq, length - 1, (void *)-1) == 0);
+    assert(bdq_pop_back(bdq) == (void *)-1);
+
+    // Out of range
+    assert(bdq_get(bdq, -1) == NULL);
+    assert(bdq_get(bdq, length - 1) == NULL);
+    assert(bdq_set(bdq, -1, NULL) == 1);
+    assert(bdq_set(bdq, length - 1, NULL) == 1);
+
+    bdq_destroy_deque(bdq);
+    printf("Passed.\n");
+}
+
+void test_block_boundary() {
+    printf("Running test_block_boundary...\n");
+    bdq_t *bdq = bdq_create_deque();
+
+    for (intptr_t i = 0; i < BDQ_BLOCK_SIZE; ++i) {
+        assert(bdq_push_back(bdq, (void *)(i + 1)) == 0);
+    }
+
+    // Crossing a block boundary back and forth keeps the same blocks
+    int blocks = bdq_get_blocks(bdq);
+    for (int i = 0; i < 1000; ++i) {
+        assert(bdq_push_back(bdq, (void *)1) == 0);
+        assert(bdq_pop_back(bdq) == (void *)1);
+        assert(bdq_push_front(bdq, (void *)1) == 0);
+        assert(bdq_pop_front(bdq) == (void *)1);
+    }
+    assert(bdq_get_blocks(bdq) <= blocks + 1);
+
+    // Draining from either end leaves at most the spare block
+    while (bdq_pop_front(bdq) != NULL) {
+    }
+    assert(bdq_get_blocks(bdq) <= 1);
+    assert(bdq_push_front(bdq, (void *)7) == 0);
+    assert(bdq_pop_back(bdq) == (void *)7);
+    assert(bdq_get_blocks(bdq) <= 1);
+
+    bdq_destroy_deque(bdq);
+    printf("Passed.\n");
+}
+
+void test_against_array() {
+    printf("Running test_against_array...\n");
+    bdq_t *bdq = bdq_create_deque();
+
+    // a window in the middle of an array mirrors the deque
+    enum { CAPACITY = 8 * MANY };
+    static intptr_t model[CAPACITY];
+    int front = CAPACITY / 2, back = CAPACITY / 2;
+    uint64_t state = 88172645463325252ull;
+    intptr_t next = 1;
+
+    for (int step = 0; step < 200000; ++step) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+
+        // bias towards growing until the deque spans a few blocks
+        int length = back - front;
+        int op = (int) (state % 4);
+        if (length > 4 * BDQ_BLOCK_SIZE && op < 2) {
+            op += 2;
+        }
+        if (front == 0 || back == CAPACITY) {
+            op = 2 + op % 2;
+        }
+
+        switch (op) {
+        case 0:
+            assert(bdq_push_front(bdq, (void *)next) == 0);
+            model[--front] = next++;
+            break;
+        case 1:
+            assert(bdq_push_back(bdq, (void *)next) == 0);
+            model[back++] = next++;
+            break;
+        case 2:
+            assert(bdq_pop_front(bdq) == (length > 0 ? (void *)model[front++] : NULL));
+            break;
+        default:
+            assert(bdq_pop_back(bdq) == (length > 0 ? (void *)model[--back] : NULL));
+            break;
+        }
+
+        assert(bdq_get_length(bdq) == back - front);
+        if (back > front) {
+            int pos = (int) ((state >> 32) % (uint64_t) (back - front));
+            assert(bdq_get(bdq, pos) == (void *)model[front + pos]);
+        }
+    }
+
+    bdq_destroy_deque(bdq);
+    printf("Passed.\n");
+}
+
+int main(void) {
+    test_push_and_pop();
+    test_many_blocks();
+    test_indexing();
+    test_block_boundary();
+    test_against_array();
+    printf("All tests passed successfully.\n");
+    return 0;
+}
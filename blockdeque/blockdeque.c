@@ -0,0 +1,215 @@
+#include "blockdeque.h"
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+_Static_assert((BDQ_BLOCK_SIZE & (BDQ_BLOCK_SIZE - 1)) == 0, "BDQ_BLOCK_SIZE must be a power of two");
+
+#define BDQ_INITIAL_MAP 8
+
+// element i lives at offset first + i counted from the first block in use
+typedef struct Bdq {
+    void ***map; // circular, capacity a power of two
+    int map_capacity;
+    int map_head; // map index of the first block in use
+    int blocks; // blocks in use
+    int first; // offset of the front element in the first block
+    int length;
+    void **spare; // a released block kept so pops and pushes across a boundary don't thrash
+} bdq_t;
+
+static void **block_at(bdq_t *bdq, int index) {
+    return bdq->map[(bdq->map_head + index) & (bdq->map_capacity - 1)];
+}
+
+static void **new_block(bdq_t *bdq) {
+    void **block = bdq->spare;
+    if (block != NULL) {
+        bdq->spare = NULL;
+        return block;
+    }
+    return (void **) malloc(BDQ_BLOCK_SIZE * sizeof(void *));
+}
+
+static void release_block(bdq_t *bdq, void **block) {
+    if (bdq->spare == NULL) {
+        bdq->spare = block;
+    } else {
+        free(block);
+    }
+}
+
+// doubles the map, unrolling it so the first block is at index 0
+static int grow_map(bdq_t *bdq) {
+    if (bdq->map_capacity > INT_MAX / 2) {
+        return 1;
+    }
+
+    int capacity = bdq->map_capacity * 2;
+    void ***map = (void ***) malloc(capacity * sizeof(void **));
+    if (map == NULL) {
+        return 1;
+    }
+    for (int i = 0; i < bdq->blocks; ++i) {
+        map[i] = block_at(bdq, i);
+    }
+
+    free(bdq->map);
+    bdq->map = map;
+    bdq->map_capacity = capacity;
+    bdq->map_head = 0;
+    return 0;
+}
+
+bdq_t *bdq_create_deque(void) {
+    bdq_t *bdq = (bdq_t *) calloc(1, sizeof(bdq_t));
+    if (bdq == NULL) {
+        return NULL;
+    }
+
+    bdq->map = (void ***) malloc(BDQ_INITIAL_MAP * sizeof(void **));
+    if (bdq->map == NULL) {
+        free(bdq);
+        return NULL;
+    }
+    bdq->map_capacity = BDQ_INITIAL_MAP;
+
+    return bdq;
+}
+
+void bdq_destroy_deque(bdq_t *bdq) {
+    for (int i = 0; i < bdq->blocks; ++i) {
+        free(block_at(bdq, i));
+    }
+    free(bdq->spare);
+    free(bdq->map);
+    free(bdq);
+}
+
+int bdq_push_front(bdq_t *bdq, void *data) {
+    if (bdq->length == INT_MAX) {
+        return 1;
+    }
+
+    // the first block is full, or there is none
+    if (bdq->first == 0) {
+        if (bdq->blocks == bdq->map_capacity && grow_map(bdq) != 0) {
+            return 1;
+        }
+        void **block = new_block(bdq);
+        if (block == NULL) {
+            return 1;
+        }
+
+        bdq->map_head = (bdq->map_head - 1) & (bdq->map_capacity - 1);
+        bdq->map[bdq->map_head] = block;
+        bdq->blocks++;
+        bdq->first = BDQ_BLOCK_SIZE;
+    }
+
+    bdq->first--;
+    block_at(bdq, 0)[bdq->first] = data;
+    bdq->length++;
+
+    return 0;
+}
+
+int bdq_push_back(bdq_t *bdq, void *data) {
+    if (bdq->length == INT_MAX) {
+        return 1;
+    }
+
+    // offsets are relative to the first block, so they stay below INT_MAX + BDQ_BLOCK_SIZE
+    unsigned offset = (unsigned) bdq->first + (unsigned) bdq->length;
+    int index = (int) (offset / BDQ_BLOCK_SIZE);
+
+    // the last block is full, or there is none
+    if (index == bdq->blocks) {
+        if (bdq->blocks == bdq->map_capacity && grow_map(bdq) != 0) {
+            return 1;
+        }
+        void **block = new_block(bdq);
+        if (block == NULL) {
+            return 1;
+        }
+
+        bdq->map[(bdq->map_head + bdq->blocks) & (bdq->map_capacity - 1)] = block;
+        bdq->blocks++;
+    }
+
+    block_at(bdq, index)[offset % BDQ_BLOCK_SIZE] = data;
+    bdq->length++;
+
+    return 0;
+}
+
+void *bdq_pop_front(bdq_t *bdq) {
+    // empty check
+    if (bdq->length == 0) {
+        return NULL;
+    }
+
+    void **block = block_at(bdq, 0);
+    void *data = block[bdq->first];
+    bdq->first++;
+    bdq->length--;
+
+    // the first block is used up
+    if (bdq->first == BDQ_BLOCK_SIZE) {
+        bdq->map_head = (bdq->map_head + 1) & (bdq->map_capacity - 1);
+        bdq->blocks--;
+        bdq->first = 0;
+        release_block(bdq, block);
+    }
+
+    return data;
+}
+
+void *bdq_pop_back(bdq_t *bdq) {
+    // empty check
+    if (bdq->length == 0) {
+        return NULL;
+    }
+
+    bdq->length--;
+    unsigned offset = (unsigned) bdq->first + (unsigned) bdq->length;
+    int index = (int) (offset / BDQ_BLOCK_SIZE);
+    void **block = block_at(bdq, index);
+    void *data = block[offset % BDQ_BLOCK_SIZE];
+
+    // the element was the only one left in the last block
+    if (offset % BDQ_BLOCK_SIZE == 0) {
+        bdq->blocks--;
+        release_block(bdq, block);
+    }
+
+    return data;
+}
+
+void *bdq_get(bdq_t *bdq, int pos) {
+    if (pos < 0 || pos >= bdq->length) {
+        return NULL;
+    }
+
+    unsigned offset = (unsigned) bdq->first + (unsigned) pos;
+    return block_at(bdq, (int) (offset / BDQ_BLOCK_SIZE))[offset % BDQ_BLOCK_SIZE];
+}
+
+int bdq_set(bdq_t *bdq, int pos, void *data) {
+    if (pos < 0 || pos >= bdq->length) {
+        return 1;
+    }
+
+    unsigned offset = (unsigned) bdq->first + (unsigned) pos;
+    block_at(bdq, (int) (offset / BDQ_BLOCK_SIZE))[offset % BDQ_BLOCK_SIZE] = data;
+
+    return 0;
+}
+
+int bdq_get_length(bdq_t *bdq) {
+    return bdq->length;
+}
+
+int bdq_get_blocks(bdq_t *bdq) {
+    return bdq->blocks + (bdq->spare != NULL);
+}
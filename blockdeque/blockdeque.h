@@ -0,0 +1,112 @@
+/**
+ * @file blockdeque.h
+ * @brief A double-ended queue of generic data stored in fixed-size blocks.
+ * @note Elements live in blocks of BDQ_BLOCK_SIZE slots, and a circular map
+ * of block pointers keeps the blocks in order. Pushing or popping at either
+ * end is amortized O(1) and allocates or frees at most one block, never one
+ * node per element. Indexing is O(1). Pointers to elements stay valid while
+ * the deque only grows or shrinks at its ends.
+ * This library stores data using `void*` pointers. The user is responsible
+ * for managing the memory of the data stored in the deque.
+ */
+#ifndef BLOCKDEQUE_H
+#define BLOCKDEQUE_H
+
+/**
+ * @brief The number of elements in a block, a power of two.
+ * @ingroup BlockDeque
+ */
+#ifndef BDQ_BLOCK_SIZE
+#define BDQ_BLOCK_SIZE 64
+#endif
+
+/**
+ * @brief A block deque structure.
+ * @ingroup BlockDeque
+ */
+typedef struct Bdq bdq_t;
+
+/**
+ * @brief Creates a new, empty deque.
+ * @return A pointer to the new deque, or NULL on failure.
+ * @ingroup BlockDeque
+ */
+bdq_t *bdq_create_deque(void);
+
+/**
+ * @brief Destroys the deque and releases all of its blocks.
+ * @param bdq A pointer to the deque.
+ * @ingroup BlockDeque
+ */
+void bdq_destroy_deque(bdq_t *bdq);
+
+/**
+ * @brief Adds data to the front of the deque.
+ * @param bdq A pointer to the deque.
+ * @param data The data to add.
+ * @return 0 on success, 1 on failure.
+ * @ingroup BlockDeque
+ */
+int bdq_push_front(bdq_t *bdq, void *data);
+
+/**
+ * @brief Adds data to the back of the deque.
+ * @param bdq A pointer to the deque.
+ * @param data The data to add.
+ * @return 0 on success, 1 on failure.
+ * @ingroup BlockDeque
+ */
+int bdq_push_back(bdq_t *bdq, void *data);
+
+/**
+ * @brief Removes the first element of the deque.
+ * @param bdq A pointer to the deque.
+ * @return The data of the removed element, or NULL if the deque is empty.
+ * @ingroup BlockDeque
+ */
+void *bdq_pop_front(bdq_t *bdq);
+
+/**
+ * @brief Removes the last element of the deque.
+ * @param bdq A pointer to the deque.
+ * @return The data of the removed element, or NULL if the deque is empty.
+ * @ingroup BlockDeque
+ */
+void *bdq_pop_back(bdq_t *bdq);
+
+/**
+ * @brief Gets the data at a position.
+ * @param bdq A pointer to the deque.
+ * @param pos The position, 0 being the front.
+ * @return The data at the position, or NULL if the position is out of range.
+ * @ingroup BlockDeque
+ */
+void *bdq_get(bdq_t *bdq, int pos);
+
+/**
+ * @brief Replaces the data at a position.
+ * @param bdq A pointer to the deque.
+ * @param pos The position, 0 being the front.
+ * @param data The new data.
+ * @return 0 on success, 1 if the position is out of range.
+ * @ingroup BlockDeque
+ */
+int bdq_set(bdq_t *bdq, int pos, void *data);
+
+/**
+ * @brief Gets the number of elements in the deque.
+ * @param bdq A pointer to the deque.
+ * @return The number of elements.
+ * @ingroup BlockDeque
+ */
+int bdq_get_length(bdq_t *bdq);
+
+/**
+ * @brief Gets the number of blocks currently allocated.
+ * @param bdq A pointer to the deque.
+ * @return The number of blocks, including one kept spare after popping.
+ * @ingroup BlockDeque
+ */
+int bdq_get_blocks(bdq_t *bdq);
+
+#endif // BLOCKDEQUE_H
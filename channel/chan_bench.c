@@ -0,0 +1,228 @@
+/*
+ * Benchmarks for the channel.
+ *
+ * - send/recv throughput on one thread and between two threads, single and
+ *   batched, bounded and unbounded
+ * - handoff latency p50/p99 for paced and bursty producers, against the
+ *   mutex guarded singly linked list polled with a sleep it replaces
+ *
+ * usage: chan_bench [--format=csv|json] [--warmup=N] [--repetitions=N]
+ *                   [--filter=TEXT]
+ */
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+#include <pthread.h>
+#include "channel.h"
+#include "../singlylinkedlist/singlylinkedlist.h"
+#include "../bench/bench.h"
+
+#define CONSTANT_BATCH 1000L
+#define TRANSFER_BATCH 100000L
+#define RECV_BATCH 64
+#define BOUNDED_CAPACITY 1024
+#define LATENCY_MESSAGES 2048L // a multiple of LATENCY_BURST
+#define LATENCY_BURST 64
+#define PACE_NS 20000L
+#define POLL_SLEEP_NS 1000000L
+
+typedef struct {
+    chan_t *chan;
+    long ops;
+    int batched;
+    pthread_t thread;
+} chan_bench_t;
+
+static void sleep_ns(long ns) {
+    struct timespec ts = { 0, ns };
+    nanosleep(&ts, NULL);
+}
+
+static void run_send_recv(void *ctx, long ops) {
+    chan_bench_t *b = ctx;
+    void *data = NULL;
+    for (intptr_t i = 1; i <= ops; ++i) {
+        chan_send(b->chan, (void *)i);
+    }
+    for (long i = 0; i < ops; ++i) {
+        chan_recv(b->chan, &data);
+    }
+}
+
+static void run_send_recv_batch(void *ctx, long ops) {
+    chan_bench_t *b = ctx;
+    void *data[RECV_BATCH];
+    for (long i = 0; i < ops; i += RECV_BATCH) {
+        int count = ops - i < RECV_BATCH ? (int) (ops - i) : RECV_BATCH;
+        for (int j = 0; j < count; ++j) {
+            data[j] = (void *)(intptr_t) (i + j + 1);
+        }
+        chan_send_batch(b->chan, data, count);
+    }
+    for (long received = 0; received < ops; ) {
+        received += chan_recv_batch(b->chan, data, RECV_BATCH);
+    }
+}
+
+static void *transfer_producer(void *arg) {
+    chan_bench_t *b = arg;
+    for (intptr_t i = 1; i <= b->ops; ++i) {
+        chan_send(b->chan, (void *)i);
+    }
+    return NULL;
+}
+
+// a producer thread sends, the benchmark thread receives
+static void run_transfer(void *ctx, long ops) {
+    chan_bench_t *b = ctx;
+    void *data[RECV_BATCH];
+
+    b->ops = ops;
+    pthread_create(&b->thread, NULL, transfer_producer, b);
+    for (long received = 0; received < ops; ) {
+        received += b->batched ? chan_recv_batch(b->chan, data, RECV_BATCH)
+                               : (chan_recv(b->chan, data) == 0);
+    }
+    pthread_join(b->thread, NULL);
+}
+
+typedef struct {
+    chan_t *chan;
+    int batched;
+    pthread_mutex_t lock;
+    sll_t *list;
+    uint64_t *samples;
+    long count;
+} latency_bench_t;
+
+// messages carry their send time, the receiver records the difference
+static void *chan_latency_consumer(void *arg) {
+    latency_bench_t *b = arg;
+    void *data[LATENCY_BURST];
+
+    while (b->count < LATENCY_MESSAGES) {
+        int count = b->batched ? chan_recv_batch(b->chan, data, LATENCY_BURST)
+                               : (chan_recv(b->chan, data) == 0);
+        uint64_t now = bench_now_ns();
+        for (int i = 0; i < count; ++i) {
+            b->samples[b->count++] = now - (uint64_t)(uintptr_t) data[i];
+        }
+    }
+    return NULL;
+}
+
+static void *sll_poll_consumer(void *arg) {
+    latency_bench_t *b = arg;
+
+    while (b->count < LATENCY_MESSAGES) {
+        pthread_mutex_lock(&b->lock);
+        int length = sll_get_length(b->list);
+        void *data = length > 0 ? sll_delete_tail_node(b->list) : NULL;
+        pthread_mutex_unlock(&b->lock);
+
+        if (length == 0) {
+            sleep_ns(POLL_SLEEP_NS);
+            continue;
+        }
+        b->samples[b->count++] = bench_now_ns() - (uint64_t)(uintptr_t) data;
+    }
+    return NULL;
+}
+
+// sends LATENCY_MESSAGES in bursts of the given size with a pause in between
+static void run_latency(latency_bench_t *b, int burst) {
+    pthread_t thread;
+    void *data[LATENCY_BURST];
+
+    b->count = 0;
+    pthread_create(&thread, NULL, b->chan != NULL ? chan_latency_consumer : sll_poll_consumer, b);
+    for (long sent = 0; sent < LATENCY_MESSAGES; sent += burst) {
+        sleep_ns(PACE_NS);
+        if (b->chan == NULL) {
+            pthread_mutex_lock(&b->lock);
+            for (int i = 0; i < burst; ++i) {
+                sll_add_head_node(b->list, (void *)(uintptr_t) bench_now_ns());
+            }
+            pthread_mutex_unlock(&b->lock);
+        } else if (burst == 1) {
+            chan_send(b->chan, (void *)(uintptr_t) bench_now_ns());
+        } else {
+            for (int i = 0; i < burst; ++i) {
+                data[i] = (void *)(uintptr_t) bench_now_ns();
+            }
+            chan_send_batch(b->chan, data, burst);
+        }
+    }
+    pthread_join(thread, NULL);
+}
+
+int main(int argc, char **argv) {
+    bench_config_t config;
+    if (bench_parse_args(&config, argc, argv) != 0) {
+        return 1;
+    }
+
+    chan_bench_t b = { 0 };
+    bench_begin(&config);
+
+    int capacities[2] = { 0, BOUNDED_CAPACITY };
+    const char *workloads[2] = { "unbounded", "bounded" };
+    for (int c = 0; c < 2; ++c) {
+        b.chan = chan_create(capacities[c]);
+        if (b.chan == NULL) {
+            return 1;
+        }
+
+        bench_run(&config, "chan", "chan_send_recv", workloads[c], capacities[c],
+                  CONSTANT_BATCH, run_send_recv, NULL, &b);
+        bench_run(&config, "chan", "chan_send_recv_batch", workloads[c], capacities[c],
+                  CONSTANT_BATCH, run_send_recv_batch, NULL, &b);
+
+        b.batched = 0;
+        bench_run(&config, "chan", "chan_transfer_recv", workloads[c], capacities[c],
+                  TRANSFER_BATCH, run_transfer, NULL, &b);
+        b.batched = 1;
+        bench_run(&config, "chan", "chan_transfer_recv_batch", workloads[c], capacities[c],
+                  TRANSFER_BATCH, run_transfer, NULL, &b);
+
+        chan_destroy(b.chan);
+    }
+
+    latency_bench_t l = { 0 };
+    l.samples = (uint64_t *) malloc(LATENCY_MESSAGES * sizeof(uint64_t));
+    if (l.samples == NULL) {
+        return 1;
+    }
+
+    if (bench_enabled(&config, "chan", "chan_recv", "paced")) {
+        l.chan = chan_create(0);
+        l.batched = 0;
+        run_latency(&l, 1);
+        bench_latency(&config, "chan", "chan_recv", "paced", 0, l.samples, l.count);
+        chan_destroy(l.chan);
+    }
+
+    if (bench_enabled(&config, "chan", "chan_recv_batch", "burst")) {
+        l.chan = chan_create(0);
+        l.batched = 1;
+        run_latency(&l, LATENCY_BURST);
+        bench_latency(&config, "chan", "chan_recv_batch", "burst", 0, l.samples, l.count);
+        chan_destroy(l.chan);
+    }
+
+    if (bench_enabled(&config, "sll", "sll_locked_poll", "paced")) {
+        l.chan = NULL;
+        l.list = sll_create_linked_list();
+        pthread_mutex_init(&l.lock, NULL);
+        run_latency(&l, 1);
+        bench_latency(&config, "sll", "sll_locked_poll", "paced", 0, l.samples, l.count);
+        pthread_mutex_destroy(&l.lock);
+        sll_destroy_linked_list(l.list);
+    }
+
+    free(l.samples);
+    bench_end(&config);
+    return 0;
+}
@@ -0,0 +1,232 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <assert.h>
+#include <pthread.h>
+#include "channel.h"
+
+#define CONCURRENT_PRODUCERS 3
+#define CONCURRENT_CONSUMERS 3
+#define CONCURRENT_ITEMS 30000
+#define CONCURRENT_BATCH 7
+
+void test_create() {
+    printf("Running test_create...\n");
+    chan_t *chan = chan_create(0);
+    assert(chan != NULL);
+    assert(chan_get_length(chan) == 0);
+    assert(chan_get_capacity(chan) == 0);
+    chan_destroy(chan);
+
+    chan = chan_create(4);
+    assert(chan != NULL);
+    assert(chan_get_capacity(chan) == 4);
+    chan_destroy(chan);
+
+    assert(chan_create(-1) == NULL);
+    printf("Passed.\n");
+}
+
+void test_send_and_recv() {
+    printf("Running test_send_and_recv...\n");
+    chan_t *chan = chan_create(0);
+    void *data = NULL;
+
+    // FIFO across refills of the receive side
+    assert(chan_send(chan, (void *)1) == 0);
+    assert(chan_send(chan, (void *)2) == 0);
+    assert(chan_recv(chan, &data) == 0 && data == (void *)1);
+    assert(chan_send(chan, (void *)3) == 0);
+    assert(chan_recv(chan, &data) == 0 && data == (void *)2);
+    assert(chan_recv(chan, &data) == 0 && data == (void *)3);
+    assert(chan_get_length(chan) == 0);
+
+    // NULL is a valid item
+    assert(chan_send(chan, NULL) == 0);
+    data = (void *)1;
+    assert(chan_try_recv(chan, &data) == 0 && data == NULL);
+
+    // Receive from empty
+    assert(chan_try_recv(chan, &data) == 1);
+
+    chan_destroy(chan);
+    printf("Passed.\n");
+}
+
+void test_bounded() {
+    printf("Running test_bounded...\n");
+    chan_t *chan = chan_create(2);
+    void *data = NULL;
+
+    assert(chan_try_send(chan, (void *)1) == 0);
+    assert(chan_try_send(chan, (void *)2) == 0);
+    assert(chan_try_send(chan, (void *)3) == 1);
+    assert(chan_get_length(chan) == 2);
+
+    assert(chan_try_recv(chan, &data) == 0 && data == (void *)1);
+    assert(chan_try_send(chan, (void *)3) == 0);
+    assert(chan_try_recv(chan, &data) == 0 && data == (void *)2);
+    assert(chan_try_recv(chan, &data) == 0 && data == (void *)3);
+
+    chan_destroy(chan);
+    printf("Passed.\n");
+}
+
+void test_batch() {
+    printf("Running test_batch...\n");
+    chan_t *chan = chan_create(0);
+    void *in[5] = { (void *)1, (void *)2, (void *)3, (void *)4, (void *)5 };
+    void *out[5] = { 0 };
+
+    assert(chan_send_batch(chan, in, 5) == 5);
+    assert(chan_get_length(chan) == 5);
+
+    // at most max items, oldest first
+    assert(chan_recv_batch(chan, out, 3) == 3);
+    assert(out[0] == (void *)1 && out[1] == (void *)2 && out[2] == (void *)3);
+
+    // fewer items than max
+    assert(chan_recv_batch(chan, out, 5) == 2);
+    assert(out[0] == (void *)4 && out[1] == (void *)5);
+
+    assert(chan_recv_batch(chan, out, 0) == 0);
+
+    chan_destroy(chan);
+    printf("Passed.\n");
+}
+
+void test_close() {
+    printf("Running test_close...\n");
+    chan_t *chan = chan_create(0);
+    void *in[2] = { (void *)1, (void *)2 };
+    void *data = NULL;
+
+    assert(chan_send(chan, (void *)1) == 0);
+    chan_close(chan);
+
+    // sends fail, queued items are still received
+    assert(chan_send(chan, (void *)2) == 1);
+    assert(chan_try_send(chan, (void *)2) == 1);
+    assert(chan_send_batch(chan, in, 2) == 0);
+    assert(chan_recv(chan, &data) == 0 && data == (void *)1);
+    assert(chan_recv(chan, &data) == 1);
+    assert(chan_recv_batch(chan, &data, 1) == 0);
+
+    chan_destroy(chan);
+    printf("Passed.\n");
+}
+
+static void *blocked_receiver(void *arg) {
+    void *data = NULL;
+    return (void *)(intptr_t) chan_recv((chan_t *) arg, &data);
+}
+
+void test_close_wakes_receiver() {
+    printf("Running test_close_wakes_receiver...\n");
+    chan_t *chan = chan_create(0);
+    pthread_t thread;
+    void *ret = NULL;
+
+    assert(pthread_create(&thread, NULL, blocked_receiver, chan) == 0);
+    chan_close(chan);
+    pthread_join(thread, &ret);
+    assert(ret == (void *)1);
+
+    chan_destroy(chan);
+    printf("Passed.\n");
+}
+
+static chan_t *shared_chan;
+static atomic_long received_sum;
+static atomic_int received_count;
+
+static void *producer(void *arg) {
+    intptr_t first = (intptr_t) arg;
+    void *batch[CONCURRENT_BATCH];
+
+    // items first .. first + per producer - 1, alternating single and batch sends
+    intptr_t i = first;
+    intptr_t end = first + CONCURRENT_ITEMS / CONCURRENT_PRODUCERS;
+    while (i < end) {
+        if (i % 2 == 0) {
+            assert(chan_send(shared_chan, (void *)i) == 0);
+            i++;
+            continue;
+        }
+        int count = 0;
+        while (count < CONCURRENT_BATCH && i < end) {
+            batch[count++] = (void *)i++;
+        }
+        assert(chan_send_batch(shared_chan, batch, count) == count);
+    }
+    return NULL;
+}
+
+static void *consumer(void *arg) {
+    void *batch[CONCURRENT_BATCH];
+    int use_batch = (int)(intptr_t) arg;
+
+    for (;;) {
+        int count = use_batch ? chan_recv_batch(shared_chan, batch, CONCURRENT_BATCH)
+                              : (chan_recv(shared_chan, batch) == 0);
+        if (count == 0) {
+            return NULL;
+        }
+        for (int i = 0; i < count; ++i) {
+            atomic_fetch_add(&received_sum, (long)(intptr_t) batch[i]);
+        }
+        atomic_fetch_add(&received_count, count);
+    }
+}
+
+void test_concurrent() {
+    printf("Running test_concurrent...\n");
+
+    // a small capacity makes both sides park
+    int capacities[2] = { 0, 4 };
+    for (int c = 0; c < 2; ++c) {
+        shared_chan = chan_create(capacities[c]);
+        atomic_store(&received_sum, 0);
+        atomic_store(&received_count, 0);
+
+        pthread_t producers[CONCURRENT_PRODUCERS];
+        pthread_t consumers[CONCURRENT_CONSUMERS];
+        for (int i = 0; i < CONCURRENT_CONSUMERS; ++i) {
+            assert(pthread_create(&consumers[i], NULL, consumer, (void *)(intptr_t)(i % 2)) == 0);
+        }
+        for (int i = 0; i < CONCURRENT_PRODUCERS; ++i) {
+            intptr_t first = 1 + i * (CONCURRENT_ITEMS / CONCURRENT_PRODUCERS);
+            assert(pthread_create(&producers[i], NULL, producer, (void *)first) == 0);
+        }
+
+        for (int i = 0; i < CONCURRENT_PRODUCERS; ++i) {
+            pthread_join(producers[i], NULL);
+        }
+        chan_close(shared_chan);
+        for (int i = 0; i < CONCURRENT_CONSUMERS; ++i) {
+            pthread_join(consumers[i], NULL);
+        }
+
+        // every item arrived exactly once
+        long expected = (long) CONCURRENT_ITEMS * (CONCURRENT_ITEMS + 1) / 2;
+        assert(atomic_load(&received_count) == CONCURRENT_ITEMS);
+        assert(atomic_load(&received_sum) == expected);
+        assert(chan_get_length(shared_chan) == 0);
+
+        chan_destroy(shared_chan);
+    }
+    printf("Passed.\n");
+}
+
+int main(void) {
+    test_create();
+    test_send_and_recv();
+    test_bounded();
+    test_batch();
+    test_close();
+    test_close_wakes_receiver();
+    test_concurrent();
+    printf("All tests passed successfully.\n");
+    return 0;
+}
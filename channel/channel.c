@@ -0,0 +1,250 @@
+#include "channel.h"
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include "../singlylinkedlist/singlylinkedlist.h"
+
+// polls of the length before a thread parks
+#ifndef CHAN_SPIN_LIMIT
+#define CHAN_SPIN_LIMIT 128
+#endif
+
+// channel, senders push onto the head of inbox and receivers pop from the
+// head of outbox, which is refilled by reversing inbox once it runs dry
+typedef struct Chan {
+    pthread_mutex_t lock;
+    pthread_cond_t not_empty;
+    pthread_cond_t not_full;
+    sll_t *inbox;
+    sll_t *outbox;
+    int capacity;
+    int recv_waiters; // receivers parked on not_empty
+    int send_waiters; // senders parked on not_full
+    atomic_int length; // written under the lock, read by spinning threads
+    atomic_int closed;
+} chan_t;
+
+static int chan_is_full(chan_t *chan, int length) {
+    return chan->capacity > 0 && length >= chan->capacity;
+}
+
+// spin until the channel has items or is closed, returns without a guarantee
+static void chan_spin_empty(chan_t *chan) {
+    for (int i = 0; i < CHAN_SPIN_LIMIT; ++i) {
+        if (atomic_load_explicit(&chan->length, memory_order_relaxed) > 0 ||
+            atomic_load_explicit(&chan->closed, memory_order_relaxed)) {
+            return;
+        }
+    }
+}
+
+// spin until the channel has room or is closed, returns without a guarantee
+static void chan_spin_full(chan_t *chan) {
+    for (int i = 0; i < CHAN_SPIN_LIMIT; ++i) {
+        if (!chan_is_full(chan, atomic_load_explicit(&chan->length, memory_order_relaxed)) ||
+            atomic_load_explicit(&chan->closed, memory_order_relaxed)) {
+            return;
+        }
+    }
+}
+
+// lock held, parks until the channel has items or is closed
+static void chan_wait_not_empty(chan_t *chan) {
+    while (atomic_load_explicit(&chan->length, memory_order_relaxed) == 0 &&
+           !atomic_load_explicit(&chan->closed, memory_order_relaxed)) {
+        chan->recv_waiters++;
+        pthread_cond_wait(&chan->not_empty, &chan->lock);
+        chan->recv_waiters--;
+    }
+}
+
+// lock held, parks until the channel has room or is closed
+static void chan_wait_not_full(chan_t *chan) {
+    while (chan_is_full(chan, atomic_load_explicit(&chan->length, memory_order_relaxed)) &&
+           !atomic_load_explicit(&chan->closed, memory_order_relaxed)) {
+        chan->send_waiters++;
+        pthread_cond_wait(&chan->not_full, &chan->lock);
+        chan->send_waiters--;
+    }
+}
+
+// lock held, queues up to count items and returns how many were queued
+static int chan_push(chan_t *chan, void *const *data, int count) {
+    int length = atomic_load_explicit(&chan->length, memory_order_relaxed);
+    int pushed = 0;
+
+    while (pushed < count && !chan_is_full(chan, length + pushed)) {
+        if (sll_add_head_node(chan->inbox, data[pushed]) != 0) {
+            break;
+        }
+        pushed++;
+    }
+
+    atomic_store_explicit(&chan->length, length + pushed, memory_order_relaxed);
+
+    // only the transition to non-empty needs a wakeup, the woken receiver
+    // wakes the next one if items are left
+    if (length == 0 && pushed > 0 && chan->recv_waiters > 0) {
+        pthread_cond_signal(&chan->not_empty);
+    }
+    if (!chan_is_full(chan, length + pushed) && chan->send_waiters > 0) {
+        pthread_cond_signal(&chan->not_full);
+    }
+
+    return pushed;
+}
+
+// lock held, dequeues up to max items oldest first and returns how many were dequeued
+static int chan_pop(chan_t *chan, void **data, int max) {
+    int length = atomic_load_explicit(&chan->length, memory_order_relaxed);
+    int popped = 0;
+
+    while (popped < max && popped < length) {
+        if (sll_get_length(chan->outbox) == 0) {
+            sll_t *tmp = chan->outbox;
+            chan->outbox = chan->inbox;
+            chan->inbox = tmp;
+            sll_reverse_linked_list(chan->outbox);
+        }
+        data[popped++] = sll_delete_head_node(chan->outbox);
+    }
+
+    atomic_store_explicit(&chan->length, length - popped, memory_order_relaxed);
+
+    // same as chan_push, with the roles of senders and receivers swapped
+    if (chan_is_full(chan, length) && popped > 0 && chan->send_waiters > 0) {
+        pthread_cond_signal(&chan->not_full);
+    }
+    if (length - popped > 0 && chan->recv_waiters > 0) {
+        pthread_cond_signal(&chan->not_empty);
+    }
+
+    return popped;
+}
+
+chan_t *chan_create(int capacity) {
+    if (capacity < 0) {
+        return NULL;
+    }
+
+    chan_t *chan = (chan_t *) malloc(sizeof(chan_t));
+    if (chan == NULL) {
+        return NULL;
+    }
+
+    chan->inbox = sll_create_linked_list();
+    chan->outbox = sll_create_linked_list();
+    if (chan->inbox == NULL || chan->outbox == NULL) {
+        sll_destroy_linked_list(chan->inbox);
+        sll_destroy_linked_list(chan->outbox);
+        free(chan);
+        return NULL;
+    }
+
+    pthread_mutex_init(&chan->lock, NULL);
+    pthread_cond_init(&chan->not_empty, NULL);
+    pthread_cond_init(&chan->not_full, NULL);
+    chan->capacity = capacity;
+    chan->recv_waiters = 0;
+    chan->send_waiters = 0;
+    atomic_init(&chan->length, 0);
+    atomic_init(&chan->closed, 0);
+    return chan;
+}
+
+void chan_destroy(chan_t *chan) {
+    if (chan == NULL) {
+        return;
+    }
+
+    sll_destroy_linked_list(chan->inbox);
+    sll_destroy_linked_list(chan->outbox);
+    pthread_cond_destroy(&chan->not_full);
+    pthread_cond_destroy(&chan->not_empty);
+    pthread_mutex_destroy(&chan->lock);
+    free(chan);
+}
+
+void chan_close(chan_t *chan) {
+    pthread_mutex_lock(&chan->lock);
+    atomic_store_explicit(&chan->closed, 1, memory_order_relaxed);
+    pthread_cond_broadcast(&chan->not_empty);
+    pthread_cond_broadcast(&chan->not_full);
+    pthread_mutex_unlock(&chan->lock);
+}
+
+int chan_send(chan_t *chan, void *data) {
+    return chan_send_batch(chan, &data, 1) == 1 ? 0 : 1;
+}
+
+int chan_try_send(chan_t *chan, void *data) {
+    pthread_mutex_lock(&chan->lock);
+    int pushed = 0;
+    if (!atomic_load_explicit(&chan->closed, memory_order_relaxed)) {
+        pushed = chan_push(chan, &data, 1);
+    }
+    pthread_mutex_unlock(&chan->lock);
+
+    return pushed == 1 ? 0 : 1;
+}
+
+int chan_send_batch(chan_t *chan, void *const *data, int count) {
+    int sent = 0;
+
+    while (sent < count) {
+        chan_spin_full(chan);
+
+        pthread_mutex_lock(&chan->lock);
+        chan_wait_not_full(chan);
+        if (atomic_load_explicit(&chan->closed, memory_order_relaxed)) {
+            pthread_mutex_unlock(&chan->lock);
+            break;
+        }
+
+        int pushed = chan_push(chan, data + sent, count - sent);
+        pthread_mutex_unlock(&chan->lock);
+
+        // the channel had room, so nothing was pushed only if a node could not be allocated
+        if (pushed == 0) {
+            break;
+        }
+        sent += pushed;
+    }
+
+    return sent;
+}
+
+int chan_recv(chan_t *chan, void **data) {
+    return chan_recv_batch(chan, data, 1) == 1 ? 0 : 1;
+}
+
+int chan_try_recv(chan_t *chan, void **data) {
+    pthread_mutex_lock(&chan->lock);
+    int popped = chan_pop(chan, data, 1);
+    pthread_mutex_unlock(&chan->lock);
+
+    return popped == 1 ? 0 : 1;
+}
+
+int chan_recv_batch(chan_t *chan, void **data, int max) {
+    if (max < 1) {
+        return 0;
+    }
+
+    chan_spin_empty(chan);
+
+    pthread_mutex_lock(&chan->lock);
+    chan_wait_not_empty(chan);
+    int popped = chan_pop(chan, data, max);
+    pthread_mutex_unlock(&chan->lock);
+
+    return popped;
+}
+
+int chan_get_length(chan_t *chan) {
+    return atomic_load_explicit(&chan->length, memory_order_relaxed);
+}
+
+int chan_get_capacity(chan_t *chan) {
+    return chan->capacity;
+}
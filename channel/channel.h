@@ -0,0 +1,125 @@
+/**
+ * @file channel.h
+ * @brief A blocking FIFO channel of generic data for passing work between threads.
+ * @note The channel is either bounded, where senders block while it is full,
+ * or unbounded. Receivers spin briefly before parking on a condition
+ * variable, and a wakeup is only issued when a receiver is parked and the
+ * channel turns non-empty, or a sender is parked and the channel turns
+ * non-full; a woken thread passes the wakeup on when more work is left.
+ * The try functions never block and serve callers that poll from their own
+ * event loop. The storage is a pair of singly linked lists, so items cost a
+ * node allocation each and FIFO order is kept in amortized O(1).
+ * The spin length can be set at build time with `-DCHAN_SPIN_LIMIT=N`.
+ * This library stores data using `void*` pointers. The user is responsible
+ * for managing the memory of the data stored in the channel.
+ */
+#ifndef CHANNEL_H
+#define CHANNEL_H
+
+/**
+ * @brief A channel structure.
+ * @ingroup Channel
+ */
+typedef struct Chan chan_t;
+
+/**
+ * @brief Creates a new, empty channel.
+ * @param capacity The maximum number of queued items, or 0 for an unbounded channel.
+ * @return A pointer to the new channel, or NULL on failure.
+ * @ingroup Channel
+ */
+chan_t *chan_create(int capacity);
+
+/**
+ * @brief Destroys the channel and frees its storage.
+ * @param chan A pointer to the channel.
+ * @note No other thread may access the channel during or after this call.
+ * Data still queued is not freed.
+ * @ingroup Channel
+ */
+void chan_destroy(chan_t *chan);
+
+/**
+ * @brief Closes the channel and wakes every blocked thread.
+ * @param chan A pointer to the channel.
+ * @note Sends fail after the channel is closed, while receivers drain the
+ * queued items before they fail.
+ * @ingroup Channel
+ */
+void chan_close(chan_t *chan);
+
+/**
+ * @brief Sends data, blocking while a bounded channel is full.
+ * @param chan A pointer to the channel.
+ * @param data The data to send.
+ * @return 0 on success, 1 if the channel is closed or on failure.
+ * @ingroup Channel
+ */
+int chan_send(chan_t *chan, void *data);
+
+/**
+ * @brief Sends data without blocking.
+ * @param chan A pointer to the channel.
+ * @param data The data to send.
+ * @return 0 on success, 1 if the channel is full, closed or on failure.
+ * @ingroup Channel
+ */
+int chan_try_send(chan_t *chan, void *data);
+
+/**
+ * @brief Sends several items in order, blocking while a bounded channel is full.
+ * @param chan A pointer to the channel.
+ * @param data The data to send.
+ * @param count The number of items.
+ * @return The number of items sent, less than count if the channel is closed or on failure.
+ * @note The lock is taken once for as many items as fit, and receivers are
+ * woken at most once per batch.
+ * @ingroup Channel
+ */
+int chan_send_batch(chan_t *chan, void *const *data, int count);
+
+/**
+ * @brief Receives the oldest data, blocking while the channel is empty.
+ * @param chan A pointer to the channel.
+ * @param data A pointer receiving the data.
+ * @return 0 on success, 1 if the channel is closed and empty.
+ * @ingroup Channel
+ */
+int chan_recv(chan_t *chan, void **data);
+
+/**
+ * @brief Receives the oldest data without blocking.
+ * @param chan A pointer to the channel.
+ * @param data A pointer receiving the data.
+ * @return 0 on success, 1 if the channel is empty.
+ * @ingroup Channel
+ */
+int chan_try_recv(chan_t *chan, void **data);
+
+/**
+ * @brief Receives up to max items in one lock acquisition, blocking while the channel is empty.
+ * @param chan A pointer to the channel.
+ * @param data An array receiving the data, oldest first.
+ * @param max The size of the array.
+ * @return The number of items received, 0 if the channel is closed and empty.
+ * @ingroup Channel
+ */
+int chan_recv_batch(chan_t *chan, void **data, int max);
+
+/**
+ * @brief Gets the number of queued items.
+ * @param chan A pointer to the channel.
+ * @return The number of queued items, which may be stale by the time it is used.
+ * @ingroup Channel
+ */
+int chan_get_length(chan_t *chan);
+
+/**
+ * @brief Gets the capacity of the channel.
+ * @param chan A pointer to the channel.
+ * @return The capacity, or 0 for an unbounded channel.
+ * @ingroup Channel
+ */
+int chan_get_capacity(chan_t *chan);
+
+#endif // CHANNEL_H
@@ -0,0 +1,336 @@
+/*
+ * Benchmarks for every dll_* operation across list sizes and head, tail and
+ * random-position workloads. Printing functions are not measured.
+ *
+ * usage: dll_bench [--format=csv|json] [--min-size=N] [--max-size=N]
+ *                  [--warmup=N] [--repetitions=N] [--filter=TEXT]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "doublylinkedlist.h"
+#include "../bench/bench.h"
+
+// node visits per batch for operations that walk the list
+#define LINEAR_BUDGET (1L << 22)
+// operations per batch for operations that don't
+#define CONSTANT_BATCH 1000L
+
+typedef struct {
+    dll_t *dll;
+    long size;
+    dll_t *created[CONSTANT_BATCH];
+    dll_t *fresh; // an empty list with a cold default allocator
+    dll_insert_item_t items[CONSTANT_BATCH];
+    int positions[CONSTANT_BATCH];
+    void *data[CONSTANT_BATCH];
+    volatile intptr_t sink;
+} dll_bench_t;
+
+static void *value(long i) {
+    return (void *)(intptr_t)(i + 1);
+}
+
+// restores, always O(1)
+static void restore_delete_begin(void *ctx, long ops) {
+    dll_bench_t *b = ctx;
+    for (long i = 0; i < ops; ++i) {
+        dll_delete_begin_node(b->dll);
+    }
+    b->size -= ops;
+}
+
+static void restore_add_begin(void *ctx, long ops) {
+    dll_bench_t *b = ctx;
+    for (long i = 0; i < ops; ++i) {
+        dll_add_begin_node(value(i), b->dll);
+    }
+    b->size += ops;
+}
+
+static void run_create(void *ctx, long ops) {
+    dll_bench_t *b = ctx;
+    for (long i = 0; i < ops; ++i) {
+        b->created[i] = dll_create_linked_list();
+    }
+}
+
+static void restore_create(void *ctx, long ops) {
+    dll_bench_t *b = ctx;
+    for (long i = 0; i < ops; ++i) {
+        dll_destroy_linked_list(b->created[i]);
+    }
+}
+
+// fill an empty list node by node or in one batch, so every node comes
+// from the allocator instead of the nodes a restore handed back
+static void run_fill_single(void *ctx, long ops) {
+    dll_bench_t *b = ctx;
+    for (long i = 0; i < ops; ++i) {
+        dll_add_end_node(value(i), b->fresh);
+    }
+}
+
+static void run_fill_batch(void *ctx, long ops) {
+    dll_bench_t *b = ctx;
+    dll_append_nodes(b->data, (int) ops, NULL, b->fresh);
+}
+
+static void restore_fill(void *ctx, long ops) {
+    dll_bench_t *b = ctx;
+    (void)ops;
+    dll_destroy_linked_list(b->fresh);
+    b->fresh = dll_create_linked_list();
+}
+
+static void run_add_begin(void *ctx, long ops) {
+    dll_bench_t *b = ctx;
+    for (long i = 0; i < ops; ++i) {
+        dll_add_begin_node(value(i), b->dll);
+    }
+    b->size += ops;
+}
+
+static void run_add_end(void *ctx, long ops) {
+    dll_bench_t *b = ctx;
+    for (long i = 0; i < ops; ++i) {
+        dll_add_end_node(value(i), b->dll);
+    }
+    b->size += ops;
+}
+
+static void run_insert_head(void *ctx, long ops) {
+    dll_bench_t *b = ctx;
+    for (long i = 0; i < ops; ++i) {
+        dll_insert_node(0, value(i), b->dll);
+    }
+    b->size += ops;
+}
+
+static void run_insert_tail(void *ctx, long ops) {
+    dll_bench_t *b = ctx;
+    for (long i = 0; i < ops; ++i) {
+        dll_insert_node((int) (b->size + i), value(i), b->dll);
+    }
+    b->size += ops;
+}
+
+static void run_insert_random(void *ctx, long ops) {
+    dll_bench_t *b = ctx;
+    for (long i = 0; i < ops; ++i) {
+        dll_insert_node((int) bench_random(b->size + i + 1), value(i), b->dll);
+    }
+    b->size += ops;
+}
+
+static void run_delete_begin(void *ctx, long ops) {
+    dll_bench_t *b = ctx;
+    for (long i = 0; i < ops; ++i) {
+        dll_delete_begin_node(b->dll);
+    }
+    b->size -= ops;
+}
+
+static void run_delete_end(void *ctx, long ops) {
+    dll_bench_t *b = ctx;
+    for (long i = 0; i < ops; ++i) {
+        dll_delete_end_node(b->dll);
+    }
+    b->size -= ops;
+}
+
+static void run_delete_node_head(void *ctx, long ops) {
+    dll_bench_t *b = ctx;
+    for (long i = 0; i < ops; ++i) {
+        dll_delete_node(0, b->dll);
+    }
+    b->size -= ops;
+}
+
+static void run_delete_node_tail(void *ctx, long ops) {
+    dll_bench_t *b = ctx;
+    for (long i = 0; i < ops; ++i) {
+        dll_delete_node((int) (b->size - i - 1), b->dll);
+    }
+    b->size -= ops;
+}
+
+static void run_delete_node_random(void *ctx, long ops) {
+    dll_bench_t *b = ctx;
+    for (long i = 0; i < ops; ++i) {
+        dll_delete_node((int) bench_random(b->size - i), b->dll);
+    }
+    b->size -= ops;
+}
+
+// one call per batch, positions are prepared by fill_positions
+static void run_insert_nodes(void *ctx, long ops) {
+    dll_bench_t *b = ctx;
+    dll_insert_nodes(b->items, (int) ops, NULL, b->dll);
+    b->size += ops;
+}
+
+static void run_delete_nodes(void *ctx, long ops) {
+    dll_bench_t *b = ctx;
+    dll_delete_nodes(b->positions, (int) ops, NULL, NULL, b->dll);
+    b->size -= ops;
+}
+
+static void run_append_nodes(void *ctx, long ops) {
+    dll_bench_t *b = ctx;
+    dll_append_nodes(b->data, (int) ops, NULL, b->dll);
+    b->size += ops;
+}
+
+static void run_reverse(void *ctx, long ops) {
+    dll_bench_t *b = ctx;
+    for (long i = 0; i < ops; ++i) {
+        dll_reverse_linked_list(b->dll);
+    }
+}
+
+static void run_rotate(void *ctx, long ops) {
+    dll_bench_t *b = ctx;
+    for (long i = 0; i < ops; ++i) {
+        dll_rotate_linked_list((int) (b->size / 2), b->dll);
+    }
+}
+
+static bool is_even(void *data, void *ctx) {
+    (void)ctx;
+    return (intptr_t) data % 2 == 0;
+}
+
+static void run_partition(void *ctx, long ops) {
+    dll_bench_t *b = ctx;
+    for (long i = 0; i < ops; ++i) {
+        b->sink += dll_partition_linked_list(is_even, NULL, b->dll);
+    }
+}
+
+// the data is distinct, so every node is compared and none deleted
+static void run_dedup(void *ctx, long ops) {
+    dll_bench_t *b = ctx;
+    for (long i = 0; i < ops; ++i) {
+        b->sink += dll_dedup_linked_list(NULL, NULL, NULL, b->dll);
+    }
+}
+
+static void run_size(void *ctx, long ops) {
+    dll_bench_t *b = ctx;
+    for (long i = 0; i < ops; ++i) {
+        b->sink += dll_size_linked_list(b->dll);
+    }
+}
+
+static void run_bytes(void *ctx, long ops) {
+    dll_bench_t *b = ctx;
+    for (long i = 0; i < ops; ++i) {
+        b->sink += dll_bytes_linked_list(b->dll);
+    }
+}
+
+typedef struct {
+    const char *operation;
+    const char *workload;
+    bench_fn run;
+    bench_fn restore;
+    int linear;
+} dll_case_t;
+
+static const dll_case_t cases[] = {
+    { "dll_add_begin_node",      "head",   run_add_begin,          restore_delete_begin, 0 },
+    { "dll_add_end_node",        "tail",   run_add_end,            restore_delete_begin, 0 },
+    { "dll_insert_node",         "head",   run_insert_head,        restore_delete_begin, 0 },
+    { "dll_insert_node",         "tail",   run_insert_tail,        restore_delete_begin, 0 },
+    { "dll_insert_node",         "random", run_insert_random,      restore_delete_begin, 1 },
+    { "dll_delete_begin_node",   "head",   run_delete_begin,       restore_add_begin,    0 },
+    { "dll_delete_end_node",     "tail",   run_delete_end,         restore_add_begin,    0 },
+    { "dll_delete_node",         "head",   run_delete_node_head,   restore_add_begin,    0 },
+    { "dll_delete_node",         "tail",   run_delete_node_tail,   restore_add_begin,    0 },
+    { "dll_delete_node",         "random", run_delete_node_random, restore_add_begin,    1 },
+    { "dll_insert_nodes",        "random", run_insert_nodes,       restore_delete_begin, 0 },
+    { "dll_delete_nodes",        "random", run_delete_nodes,       restore_add_begin,    0 },
+    { "dll_append_nodes",        "tail",   run_append_nodes,       restore_delete_begin, 0 },
+    { "dll_reverse_linked_list", "all",    run_reverse,            NULL,                 0 },
+    { "dll_rotate_linked_list",  "half",   run_rotate,             NULL,                 1 },
+    { "dll_partition_linked_list", "all",  run_partition,          NULL,                 1 },
+    { "dll_dedup_linked_list",   "all",    run_dedup,              NULL,                 1 },
+    { "dll_size_linked_list",    "all",    run_size,               NULL,                 0 },
+    { "dll_bytes_linked_list",   "all",    run_bytes,              NULL,                 0 },
+};
+
+// strictly increasing random positions, one per stride of the list
+static void fill_positions(dll_bench_t *b, long size, long ops) {
+    long stride = size / ops;
+    for (long i = 0; i < ops; ++i) {
+        int pos = (int) (i * stride + bench_random(stride));
+        b->positions[i] = pos;
+        b->items[i].pos = pos;
+        b->items[i].data = value(i);
+        b->data[i] = value(i);
+    }
+}
+
+// batches never shrink the list below half its size
+static long batch_size(long size, int linear) {
+    long ops = linear ? LINEAR_BUDGET / size : CONSTANT_BATCH;
+    if (ops > size / 2) {
+        ops = size / 2;
+    }
+    return ops > 0 ? ops : 1;
+}
+
+int main(int argc, char **argv) {
+    bench_config_t config;
+    if (bench_parse_args(&config, argc, argv) != 0) {
+        return 1;
+    }
+
+    dll_bench_t b = { 0 };
+    bench_begin(&config);
+
+    // independent of the list size
+    bench_run(&config, "dll", "dll_create_linked_list", "none", 0, CONSTANT_BATCH,
+              run_create, restore_create, &b);
+
+    // node allocation with the default allocator, one node per op
+    b.fresh = dll_create_linked_list();
+    if (b.fresh == NULL) {
+        return 1;
+    }
+    for (long i = 0; i < CONSTANT_BATCH; ++i) {
+        b.data[i] = value(i);
+    }
+    bench_run(&config, "dll", "dll_add_end_node", "fresh", 0, CONSTANT_BATCH,
+              run_fill_single, restore_fill, &b);
+    bench_run(&config, "dll", "dll_append_nodes", "fresh", 0, CONSTANT_BATCH,
+              run_fill_batch, restore_fill, &b);
+    dll_destroy_linked_list(b.fresh);
+
+    for (long size = config.min_size; size <= config.max_size; size *= 10) {
+        b.dll = dll_create_linked_list();
+        if (b.dll == NULL) {
+            return 1;
+        }
+        b.size = size;
+        for (long i = 0; i < size; ++i) {
+            if (dll_add_begin_node(value(i), b.dll) != 1) {
+                return 1;
+            }
+        }
+
+        fill_positions(&b, size, batch_size(size, 0));
+
+        for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); ++i) {
+            const dll_case_t *c = &cases[i];
+            bench_run(&config, "dll", c->operation, c->workload, size,
+                      batch_size(size, c->linear), c->run, c->restore, &b);
+        }
+
+        dll_destroy_linked_list(b.dll);
+    }
+
+    bench_end(&config);
+    return 0;
+}
@@ -0,0 +1,409 @@
+/*
+ * Differential fuzzing of the doubly linked list against an array model.
+ *
+ * Replays a random sequence of every dll_* operation, including positions
+ * out of range and operations on the empty list, and checks the results,
+ * every node and prev link and the node count after each step. Built with
+ * CLIBSTRUCT_STATS it also bounds the nodes each operation walks. Finally
+ * the constant time operations are timed on a small and a large list.
+ *
+ * usage: dll_fuzz [--seed=N] [--ops=N] [--max-size=N] [--large-size=N]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "doublylinkedlist.h"
+#include "../fuzz/fuzz.h"
+
+#define MAX_BATCH 8
+
+typedef enum {
+    FUZZ_ADD_BEGIN,
+    FUZZ_ADD_END,
+    FUZZ_INSERT,
+    FUZZ_DELETE_BEGIN,
+    FUZZ_DELETE_END,
+    FUZZ_DELETE,
+    FUZZ_REVERSE,
+    FUZZ_SIZE,
+    FUZZ_BYTES,
+    FUZZ_INSERT_BATCH,
+    FUZZ_DELETE_BATCH,
+    FUZZ_APPEND_BATCH,
+    FUZZ_ROTATE,
+    FUZZ_PARTITION,
+    FUZZ_DEDUP,
+    FUZZ_OP_COUNT
+} fuzz_op_t;
+
+static dll_t *list = NULL;
+static fuzz_model_t model;
+static intptr_t next_value = 1;
+
+// distinct and never NULL, so a failed delete can't pass for a match
+static void *next_data(void) {
+    return (void *) next_value++;
+}
+
+// the data dedup hands to collect, next to the data the model removed
+typedef struct {
+    void **items;
+    void **expected;
+    int count;
+} released_t;
+
+static released_t released;
+
+static bool divisible(void *data, void *ctx) {
+    return (intptr_t) data % *(intptr_t *) ctx == 0;
+}
+
+// values in the same group of four are duplicates, so appends form runs
+static bool same_group(void *a, void *b, void *ctx) {
+    (void)ctx;
+    return (intptr_t) a / 4 == (intptr_t) b / 4;
+}
+
+static void collect(void *data, void *ctx) {
+    released_t *r = ctx;
+    FUZZ_CHECK(r->count < model.capacity);
+    r->items[r->count++] = data;
+}
+
+static void check_list(void) {
+    dll_node_t *ptr = dll_get_head(list);
+    dll_node_t *last = NULL;
+    for (int i = 0; i < model.length; ++i) {
+        FUZZ_CHECK(ptr != NULL);
+        FUZZ_CHECK(dll_node_data(ptr) == model.items[i]);
+        FUZZ_CHECK(dll_prev_node(ptr, list) == last);
+        last = ptr;
+        ptr = dll_next_node(ptr, list);
+    }
+    FUZZ_CHECK(ptr == NULL);
+    FUZZ_CHECK(dll_get_tail(list) == last);
+
+    la_usage_t usage;
+    dll_memory_usage(&usage, list);
+    FUZZ_CHECK(usage.nodes == (size_t) model.length);
+}
+
+#ifdef CLIBSTRUCT_STATS
+static uint64_t walked(dll_op_t op) {
+    dll_stats_t stats;
+    dll_get_stats(&stats, list);
+    return stats.nodes_traversed[op];
+}
+
+#define CHECK_WALK(op, before, bound) FUZZ_CHECK(walked(op) - (before) <= (uint64_t) (bound))
+#else
+static uint64_t walked(dll_op_t op) {
+    (void)op;
+    return 0;
+}
+
+#define CHECK_WALK(op, before, bound) ((void)(before), (void)(bound))
+#endif
+
+// the nodes walked to reach a position from the nearer end
+static int nearer(int pos, int length) {
+    return pos <= length / 2 ? pos : length - 1 - pos;
+}
+
+// a position in [-1, length + 1], so both bounds are exercised
+static int random_pos(int length) {
+    return (int) fuzz_random(length + 3) - 1;
+}
+
+// count positions in [0, bound), sorted, with an occasional pair out of order
+static void random_positions(int *positions, int count, int bound) {
+    for (int i = 0; i < count; ++i) {
+        int pos = (int) fuzz_random(bound);
+        int j = i;
+        while (j > 0 && positions[j - 1] > pos) {
+            positions[j] = positions[j - 1];
+            j--;
+        }
+        positions[j] = pos;
+    }
+
+    if (count > 1 && fuzz_random(4) == 0) {
+        int i = (int) fuzz_random(count - 1);
+        int tmp = positions[i];
+        positions[i] = positions[i + 1];
+        positions[i + 1] = tmp;
+    }
+}
+
+static void step(fuzz_op_t op, int max_size) {
+    int length = model.length;
+    int pos = random_pos(length);
+    int count = (int) fuzz_random(MAX_BATCH) + 1;
+    int positions[MAX_BATCH];
+    void *data[MAX_BATCH];
+    void *expected[MAX_BATCH];
+    int status[MAX_BATCH];
+    int expected_status[MAX_BATCH];
+
+    // keep the list below max_size
+    if (length >= max_size) {
+        if (op == FUZZ_ADD_BEGIN || op == FUZZ_ADD_END || op == FUZZ_INSERT) {
+            op = FUZZ_DELETE;
+        } else if (op == FUZZ_INSERT_BATCH || op == FUZZ_APPEND_BATCH) {
+            op = FUZZ_DELETE_BATCH;
+        }
+    }
+
+    switch (op) {
+    case FUZZ_ADD_BEGIN: {
+        uint64_t before = walked(DLL_OP_ADD_BEGIN);
+        void *value = next_data();
+        FUZZ_CHECK(dll_add_begin_node(value, list) == 1);
+        fuzz_model_insert(&model, 0, value);
+        CHECK_WALK(DLL_OP_ADD_BEGIN, before, 0);
+        break;
+    }
+    case FUZZ_ADD_END: {
+        uint64_t before = walked(DLL_OP_ADD_END);
+        void *value = next_data();
+        FUZZ_CHECK(dll_add_end_node(value, list) == 1);
+        fuzz_model_insert(&model, length, value);
+        CHECK_WALK(DLL_OP_ADD_END, before, 0);
+        break;
+    }
+    case FUZZ_INSERT: {
+        uint64_t before = walked(DLL_OP_INSERT);
+        void *value = next_data();
+        int ok = fuzz_model_insert(&model, pos, value) == 0;
+        FUZZ_CHECK(dll_insert_node(pos, value, list) == ok);
+        CHECK_WALK(DLL_OP_INSERT, before, ok && pos < length ? nearer(pos, length) : 0);
+        break;
+    }
+    case FUZZ_DELETE_BEGIN: {
+        uint64_t before = walked(DLL_OP_DELETE_BEGIN);
+        FUZZ_CHECK(dll_delete_begin_node(list) == fuzz_model_delete(&model, 0));
+        CHECK_WALK(DLL_OP_DELETE_BEGIN, before, 0);
+        break;
+    }
+    case FUZZ_DELETE_END: {
+        uint64_t before = walked(DLL_OP_DELETE_END);
+        FUZZ_CHECK(dll_delete_end_node(list) == fuzz_model_delete(&model, length - 1));
+        CHECK_WALK(DLL_OP_DELETE_END, before, 0);
+        break;
+    }
+    case FUZZ_DELETE: {
+        uint64_t before = walked(DLL_OP_DELETE);
+        FUZZ_CHECK(dll_delete_node(pos, list) == fuzz_model_delete(&model, pos));
+        CHECK_WALK(DLL_OP_DELETE, before, pos >= 0 && pos < length ? nearer(pos, length) : 0);
+        break;
+    }
+    case FUZZ_REVERSE: {
+        uint64_t before = walked(DLL_OP_REVERSE);
+        FUZZ_CHECK(dll_reverse_linked_list(list) == (length > 0));
+        fuzz_model_reverse(&model);
+        CHECK_WALK(DLL_OP_REVERSE, before, 0);
+        break;
+    }
+    case FUZZ_SIZE: {
+        uint64_t before = walked(DLL_OP_SIZE);
+        FUZZ_CHECK(dll_size_linked_list(list) == length);
+        CHECK_WALK(DLL_OP_SIZE, before, 0);
+        break;
+    }
+    case FUZZ_BYTES: {
+        la_usage_t usage;
+        dll_memory_usage(&usage, list);
+        FUZZ_CHECK(dll_bytes_linked_list(list) == (int) usage.node_bytes);
+        break;
+    }
+    case FUZZ_INSERT_BATCH: {
+        dll_insert_item_t items[MAX_BATCH];
+        random_positions(positions, count, length + 2);
+        for (int i = 0; i < count; ++i) {
+            data[i] = next_data();
+            items[i].pos = positions[i];
+            items[i].data = data[i];
+        }
+
+        uint64_t before = walked(DLL_OP_INSERT_BATCH);
+        fuzz_model_insert_batch(&model, positions, data, count, expected_status);
+        int ok = 1;
+        for (int i = 0; i < count; ++i) {
+            ok = ok && expected_status[i] == 0;
+        }
+        FUZZ_CHECK(dll_insert_nodes(items, count, status, list) == ok);
+        for (int i = 0; i < count; ++i) {
+            FUZZ_CHECK(status[i] == !expected_status[i]);
+        }
+        CHECK_WALK(DLL_OP_INSERT_BATCH, before, length + count);
+        break;
+    }
+    case FUZZ_DELETE_BATCH: {
+        random_positions(positions, count, length + 1);
+
+        uint64_t before = walked(DLL_OP_DELETE_BATCH);
+        fuzz_model_delete_batch(&model, positions, count, expected, expected_status);
+        int ok = 1;
+        for (int i = 0; i < count; ++i) {
+            ok = ok && expected_status[i] == 0;
+        }
+        FUZZ_CHECK(dll_delete_nodes(positions, count, data, status, list) == ok);
+        for (int i = 0; i < count; ++i) {
+            FUZZ_CHECK(status[i] == !expected_status[i]);
+            FUZZ_CHECK(data[i] == expected[i]);
+        }
+        CHECK_WALK(DLL_OP_DELETE_BATCH, before, length);
+        break;
+    }
+    case FUZZ_APPEND_BATCH: {
+        for (int i = 0; i < count; ++i) {
+            data[i] = next_data();
+            fuzz_model_insert(&model, length + i, data[i]);
+        }
+
+        uint64_t before = walked(DLL_OP_APPEND_BATCH);
+        FUZZ_CHECK(dll_append_nodes(data, count, status, list) == 1);
+        for (int i = 0; i < count; ++i) {
+            FUZZ_CHECK(status[i] == 1);
+        }
+        CHECK_WALK(DLL_OP_APPEND_BATCH, before, 0);
+        break;
+    }
+    case FUZZ_ROTATE: {
+        uint64_t before = walked(DLL_OP_ROTATE);
+        int ok = fuzz_model_rotate(&model, pos) == 0;
+        FUZZ_CHECK(dll_rotate_linked_list(pos, list) == ok);
+        CHECK_WALK(DLL_OP_ROTATE, before, ok ? nearer(pos, length) : 0);
+        break;
+    }
+    case FUZZ_PARTITION: {
+        intptr_t modulus = (intptr_t) fuzz_random(3) + 1;
+        uint64_t before = walked(DLL_OP_PARTITION);
+        FUZZ_CHECK(dll_partition_linked_list(divisible, &modulus, list) == fuzz_model_partition(&model, divisible, &modulus));
+        CHECK_WALK(DLL_OP_PARTITION, before, length);
+        break;
+    }
+    case FUZZ_DEDUP: {
+        // NULL compares the pointers, which are distinct
+        bool (*equal)(void *, void *, void *) = fuzz_random(4) == 0 ? NULL : same_group;
+        released.count = 0;
+
+        uint64_t before = walked(DLL_OP_DEDUP);
+        int removed = fuzz_model_dedup(&model, equal, NULL, released.expected);
+        FUZZ_CHECK(dll_dedup_linked_list(equal, collect, &released, list) == removed);
+        FUZZ_CHECK(released.count == removed);
+        for (int i = 0; i < removed; ++i) {
+            FUZZ_CHECK(released.items[i] == released.expected[i]);
+        }
+        CHECK_WALK(DLL_OP_DEDUP, before, length);
+        break;
+    }
+    default:
+        break;
+    }
+
+    check_list();
+}
+
+static void fill(void *ctx, long n) {
+    dll_t **dll = ctx;
+    *dll = dll_create_linked_list();
+    for (long i = 0; i < n; ++i) {
+        dll_add_begin_node((void *)(intptr_t) (i + 1), *dll);
+    }
+}
+
+static void clear(void *ctx, long n) {
+    (void)n;
+    dll_destroy_linked_list(*(dll_t **) ctx);
+}
+
+static void run_begin(void *ctx, long n) {
+    dll_t *dll = *(dll_t **) ctx;
+    for (long i = 0; i < n; ++i) {
+        dll_add_begin_node((void *)1, dll);
+        dll_delete_begin_node(dll);
+    }
+}
+
+static void run_end(void *ctx, long n) {
+    dll_t *dll = *(dll_t **) ctx;
+    for (long i = 0; i < n; ++i) {
+        dll_add_end_node((void *)1, dll);
+        dll_delete_end_node(dll);
+    }
+}
+
+static void run_head(void *ctx, long n) {
+    dll_t *dll = *(dll_t **) ctx;
+    for (long i = 0; i < n; ++i) {
+        dll_insert_node(0, (void *)1, dll);
+        dll_delete_node(0, dll);
+    }
+}
+
+static void run_second(void *ctx, long n) {
+    dll_t *dll = *(dll_t **) ctx;
+    for (long i = 0; i < n; ++i) {
+        dll_insert_node(1, (void *)1, dll);
+        dll_delete_node(1, dll);
+    }
+}
+
+static void run_size(void *ctx, long n) {
+    dll_t *dll = *(dll_t **) ctx;
+    for (long i = 0; i < n; ++i) {
+        dll_size_linked_list(dll);
+    }
+}
+
+static void run_reverse(void *ctx, long n) {
+    dll_t *dll = *(dll_t **) ctx;
+    for (long i = 0; i < n; ++i) {
+        dll_reverse_linked_list(dll);
+    }
+}
+
+int main(int argc, char **argv) {
+    fuzz_config_t config;
+    if (fuzz_parse_args(&config, argc, argv) != 0) {
+        return 1;
+    }
+    if (fuzz_model_init(&model, config.max_size + MAX_BATCH) != 0) {
+        return 1;
+    }
+    released.items = (void **) malloc(model.capacity * sizeof(void *));
+    released.expected = (void **) malloc(model.capacity * sizeof(void *));
+    if (released.items == NULL || released.expected == NULL) {
+        return 1;
+    }
+
+    list = dll_create_linked_list();
+    if (list == NULL) {
+        return 1;
+    }
+
+    printf("Replaying %ld operations with seed %llu...\n", config.ops, (unsigned long long) config.seed);
+    for (long i = 0; i < config.ops; ++i) {
+        fuzz_set_step(i);
+        step((fuzz_op_t) fuzz_random(FUZZ_OP_COUNT), config.max_size);
+    }
+    dll_destroy_linked_list(list);
+    fuzz_model_free(&model);
+    free(released.items);
+    free(released.expected);
+    printf("Passed.\n");
+
+    printf("Checking constant time operations...\n");
+    dll_t *dll = NULL;
+    fuzz_check_flat(&config, "dll_add_begin_node+dll_delete_begin_node", fill, run_begin, clear, &dll);
+    fuzz_check_flat(&config, "dll_add_end_node+dll_delete_end_node", fill, run_end, clear, &dll);
+    fuzz_check_flat(&config, "dll_insert_node+dll_delete_node at 0", fill, run_head, clear, &dll);
+    fuzz_check_flat(&config, "dll_insert_node+dll_delete_node at 1", fill, run_second, clear, &dll);
+    fuzz_check_flat(&config, "dll_size_linked_list", fill, run_size, clear, &dll);
+    fuzz_check_flat(&config, "dll_reverse_linked_list", fill, run_reverse, clear, &dll);
+    printf("Passed.\n");
+
+    printf("All tests passed successfully.\n");
+    return 0;
+}
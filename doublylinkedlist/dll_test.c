@@ -0,0 +1,246 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <assert.h>
+#include "doublylinkedlist.h"
+
+// checks the list front to back against expected, the prev links, the tail and the size
+static void assert_list(dll_t *dll, void **expected, int count) {
+    dll_node_t *ptr = dll_get_head(dll);
+    dll_node_t *last = NULL;
+    for (int i = 0; i < count; ++i) {
+        assert(ptr != NULL);
+        assert(dll_node_data(ptr) == expected[i]);
+        assert(dll_prev_node(ptr, dll) == last);
+        last = ptr;
+        ptr = dll_next_node(ptr, dll);
+    }
+    assert(ptr == NULL);
+    assert(dll_get_tail(dll) == last);
+    assert(dll_size_linked_list(dll) == count);
+}
+
+void test_insert_nodes() {
+    printf("Running test_insert_nodes...\n");
+    dll_t *dll = dll_create_linked_list();
+    dll_add_end_node((void *)10, dll);
+    dll_add_end_node((void *)20, dll);
+    // [10, 20]
+
+    dll_insert_item_t items[] = {
+        { 0, (void *)1 },  // [1, 10, 20]
+        { 2, (void *)2 },  // [1, 10, 2, 20]
+        { 1, (void *)99 }, // below previous position, fails
+        { 2, (void *)3 },  // [1, 10, 3, 2, 20]
+        { 5, (void *)4 },  // [1, 10, 3, 2, 20, 4]
+        { 9, (void *)99 }, // out of range, fails
+    };
+    int status[6];
+    assert(dll_insert_nodes(items, 6, status, dll) == 0);
+    assert(status[0] == 1 && status[1] == 1 && status[2] == 0);
+    assert(status[3] == 1 && status[4] == 1 && status[5] == 0);
+
+    void *expected[] = { (void *)1, (void *)10, (void *)3, (void *)2, (void *)20, (void *)4 };
+    assert_list(dll, expected, 6);
+
+    dll_destroy_linked_list(dll);
+
+    // Everything succeeds on an empty list
+    dll = dll_create_linked_list();
+    dll_insert_item_t more[] = { { 0, (void *)1 }, { 1, (void *)2 } };
+    assert(dll_insert_nodes(more, 2, NULL, dll) == 1);
+    void *expected_more[] = { (void *)1, (void *)2 };
+    assert_list(dll, expected_more, 2);
+
+    dll_destroy_linked_list(dll);
+    printf("Passed.\n");
+}
+
+void test_delete_nodes() {
+    printf("Running test_delete_nodes...\n");
+    dll_t *dll = dll_create_linked_list();
+    void *values[] = { (void *)0, (void *)1, (void *)2, (void *)3, (void *)4, (void *)5 };
+    assert(dll_append_nodes(values, 6, NULL, dll) == 1);
+
+    int positions[] = { 0, 2, 2, 3, 5, 7 };
+    void *data[6];
+    int status[6];
+    assert(dll_delete_nodes(positions, 6, data, status, dll) == 0);
+    assert(status[0] == 1 && data[0] == (void *)0);
+    assert(status[1] == 1 && data[1] == (void *)2);
+    assert(status[2] == 0 && data[2] == NULL); // not increasing
+    assert(status[3] == 1 && data[3] == (void *)3);
+    assert(status[4] == 1 && data[4] == (void *)5); // last node
+    assert(status[5] == 0 && data[5] == NULL); // out of range
+
+    void *expected[] = { (void *)1, (void *)4 };
+    assert_list(dll, expected, 2);
+
+    // Deleting every node empties the list
+    int all[] = { 0, 1 };
+    assert(dll_delete_nodes(all, 2, NULL, NULL, dll) == 1);
+    assert_list(dll, NULL, 0);
+
+    dll_destroy_linked_list(dll);
+    printf("Passed.\n");
+}
+
+void test_append_nodes() {
+    printf("Running test_append_nodes...\n");
+    dll_t *dll = dll_create_linked_list();
+    void *data[] = { (void *)1, (void *)2, (void *)3 };
+
+    assert(dll_append_nodes(data, 3, NULL, dll) == 1);
+    assert(dll_append_nodes(data, 2, NULL, dll) == 1);
+
+    void *expected[] = { (void *)1, (void *)2, (void *)3, (void *)1, (void *)2 };
+    assert_list(dll, expected, 5);
+
+    dll_destroy_linked_list(dll);
+    printf("Passed.\n");
+}
+
+void test_list_ends() {
+    printf("Running test_list_ends...\n");
+    dll_t *dll = dll_create_linked_list();
+    assert(dll_size_linked_list(dll) == 0);
+    assert(dll_delete_end_node(dll) == NULL);
+    dll_add_begin_node((void *)1, dll);
+
+    // Deleting the only node from the front
+    assert(dll_delete_begin_node(dll) == (void *)1);
+    assert_list(dll, NULL, 0);
+
+    // Inserting at pos == size appends
+    assert(dll_insert_node(0, (void *)1, dll) == 1);
+    assert(dll_insert_node(1, (void *)2, dll) == 1);
+    assert(dll_insert_node(2, (void *)3, dll) == 1);
+    assert(dll_insert_node(4, (void *)99, dll) == 0);
+    void *expected[] = { (void *)1, (void *)2, (void *)3 };
+    assert_list(dll, expected, 3);
+
+    // Deleting the last position
+    assert(dll_delete_node(3, dll) == NULL);
+    assert(dll_delete_node(2, dll) == (void *)3);
+    assert_list(dll, expected, 2);
+    assert(dll_delete_node(1, dll) == (void *)2);
+    assert(dll_delete_node(0, dll) == (void *)1);
+    assert_list(dll, NULL, 0);
+
+    dll_destroy_linked_list(dll);
+    printf("Passed.\n");
+}
+
+static bool is_even(void *data, void *ctx) {
+    (void)ctx;
+    return (intptr_t) data % 2 == 0;
+}
+
+void test_rotate() {
+    printf("Running test_rotate...\n");
+    dll_t *dll = dll_create_linked_list();
+    assert(dll_rotate_linked_list(0, dll) == 0);
+
+    void *data[] = { (void *)1, (void *)2, (void *)3, (void *)4 };
+    dll_append_nodes(data, 4, NULL, dll);
+    assert(dll_rotate_linked_list(4, dll) == 0);
+    assert(dll_rotate_linked_list(-1, dll) == 0);
+    assert(dll_rotate_linked_list(0, dll) == 1);
+    assert_list(dll, data, 4);
+
+    assert(dll_rotate_linked_list(1, dll) == 1);
+    void *rotated[] = { (void *)2, (void *)3, (void *)4, (void *)1 };
+    assert_list(dll, rotated, 4);
+    assert(dll_rotate_linked_list(3, dll) == 1);
+    assert_list(dll, data, 4);
+
+    dll_destroy_linked_list(dll);
+    printf("Passed.\n");
+}
+
+void test_reverse() {
+    printf("Running test_reverse...\n");
+    dll_t *dll = dll_create_linked_list();
+    assert(dll_reverse_linked_list(dll) == 0);
+
+    void *data[] = { (void *)1, (void *)2, (void *)3, (void *)4 };
+    dll_append_nodes(data, 4, NULL, dll);
+    assert(dll_reverse_linked_list(dll) == 1);
+    void *reversed[] = { (void *)4, (void *)3, (void *)2, (void *)1 };
+    assert_list(dll, reversed, 4);
+
+    // Every operation follows the new direction
+    dll_add_end_node((void *)0, dll);
+    dll_add_begin_node((void *)5, dll);
+    assert(dll_insert_node(2, (void *)9, dll) == 1);
+    void *grown[] = { (void *)5, (void *)4, (void *)9, (void *)3, (void *)2, (void *)1, (void *)0 };
+    assert_list(dll, grown, 7);
+
+    assert(dll_delete_node(2, dll) == (void *)9);
+    assert(dll_delete_begin_node(dll) == (void *)5);
+    assert(dll_delete_end_node(dll) == (void *)0);
+    assert_list(dll, reversed, 4);
+
+    assert(dll_rotate_linked_list(3, dll) == 1);
+    void *rotated[] = { (void *)1, (void *)4, (void *)3, (void *)2 };
+    assert_list(dll, rotated, 4);
+
+    // Reversing twice restores the order
+    assert(dll_reverse_linked_list(dll) == 1);
+    assert(dll_reverse_linked_list(dll) == 1);
+    assert_list(dll, rotated, 4);
+
+    dll_destroy_linked_list(dll);
+    printf("Passed.\n");
+}
+
+void test_partition() {
+    printf("Running test_partition...\n");
+    dll_t *dll = dll_create_linked_list();
+    assert(dll_partition_linked_list(is_even, NULL, dll) == 0);
+
+    void *data[] = { (void *)1, (void *)2, (void *)3, (void *)4, (void *)6, (void *)5 };
+    dll_append_nodes(data, 6, NULL, dll);
+    assert(dll_partition_linked_list(is_even, NULL, dll) == 3);
+    void *expected[] = { (void *)2, (void *)4, (void *)6, (void *)1, (void *)3, (void *)5 };
+    assert_list(dll, expected, 6);
+
+    // No node matching keeps the order
+    dll_destroy_linked_list(dll);
+    dll = dll_create_linked_list();
+    void *odd[] = { (void *)1, (void *)3 };
+    dll_append_nodes(odd, 2, NULL, dll);
+    assert(dll_partition_linked_list(is_even, NULL, dll) == 0);
+    assert_list(dll, odd, 2);
+
+    dll_destroy_linked_list(dll);
+    printf("Passed.\n");
+}
+
+void test_dedup() {
+    printf("Running test_dedup...\n");
+    dll_t *dll = dll_create_linked_list();
+    assert(dll_dedup_linked_list(NULL, NULL, NULL, dll) == 0);
+
+    void *data[] = { (void *)1, (void *)1, (void *)2, (void *)3, (void *)3, (void *)3 };
+    dll_append_nodes(data, 6, NULL, dll);
+    assert(dll_dedup_linked_list(NULL, NULL, NULL, dll) == 3);
+    void *expected[] = { (void *)1, (void *)2, (void *)3 };
+    assert_list(dll, expected, 3);
+
+    dll_destroy_linked_list(dll);
+    printf("Passed.\n");
+}
+
+int main(void) {
+    test_list_ends();
+    test_insert_nodes();
+    test_delete_nodes();
+    test_append_nodes();
+    test_rotate();
+    test_reverse();
+    test_partition();
+    test_dedup();
+    printf("All tests passed successfully.\n");
+    return 0;
+}
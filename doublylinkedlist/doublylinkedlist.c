@@ -1,266 +1,737 @@
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
+#include "../liststats/liststats_internal.h"
 #include "doublylinkedlist.h"
+#include "../listalloc/listalloc_internal.h"
+
+// node, link[0] points towards the front and link[1] towards the back of the chain
+struct DllNode {
+    struct DllNode *link[2];
+    void *data;
+};
+
+// doublylinkedlist
+typedef struct Dll {
+    int length;
+    dll_node_t *end[2]; // the front and the back node of the chain
+    int reversed; // the list runs from the back to the front of the chain
+    const la_allocator_t *allocator;
+    la_pool_t pool; // the default allocator
+    la_size_fn payload_size;
+    size_t node_footprint; // allocator footprint of all nodes
+    size_t payload_bytes;
+#ifdef CLIBSTRUCT_STATS
+    dll_stats_t stats;
+    uint64_t walked; // nodes walked by the running operation
+#endif
+} dll_t;
+
+// link and end indices towards the head and the tail, they swap on reverse
+#define DLL_PREV(dll) ((dll)->reversed)
+#define DLL_NEXT(dll) (1 - (dll)->reversed)
+
+#ifdef CLIBSTRUCT_STATS
+// moves the nodes walked by the finished operation to its counters
+#define DLL_STATS_OP(dll, op, timer) do {                   \
+        (dll)->stats.op_count[op]++;                        \
+        (dll)->stats.nodes_traversed[op] += (dll)->walked;  \
+        (dll)->walked = 0;                                  \
+        LS_TIMER_RECORD(timer, (dll)->stats.latency[op]);   \
+    } while (0)
+#else
+#define DLL_STATS_OP(dll, op, timer) ((void)0)
+#endif
+
+// accounts for a freshly allocated node and stores its data
+static void dll_init_node(dll_t *dll, dll_node_t *node, void *data) {
+    const la_allocator_t *allocator = dll->allocator;
+    LS_COUNT(dll->stats.allocations);
+
+    dll->node_footprint += allocator->footprint(allocator->ctx, node, sizeof(dll_node_t));
+    if (dll->payload_size != NULL) {
+        dll->payload_bytes += dll->payload_size(data);
+    }
+
+    node->data = data;
+}
 
-dll_node_t *dll_create_linked_list(void *data) {
-    dll_node_t *headPtr = (dll_node_t *) malloc(sizeof(dll_node_t));
-    if (headPtr == NULL) {
+static dll_node_t *dll_alloc_node(dll_t *dll, void *data) {
+    const la_allocator_t *allocator = dll->allocator;
+    dll_node_t *node = (dll_node_t *) allocator->alloc(allocator->ctx, sizeof(dll_node_t));
+    if (node == NULL) {
         return NULL;
     }
 
-    headPtr->prev = NULL;
-    headPtr->data = data;
-    headPtr->next = NULL;
-
-    return headPtr;
+    dll_init_node(dll, node, data);
+    return node;
 }
 
-int dll_add_end_node(void *data, dll_node_t **headPtr) {
-    dll_node_t *newNode = (dll_node_t *) malloc(sizeof(dll_node_t));
-    if (newNode == NULL) {
-        return 0;
+// allocates count nodes in one request, chained through their first word
+static void *dll_alloc_nodes(dll_t *dll, int count) {
+    size_t allocated = 0;
+    if (count <= 0) {
+        return NULL;
     }
 
-    newNode->data = data;
-    newNode->next = NULL;
+    return la_alloc_many(dll->allocator, sizeof(dll_node_t), (size_t) count, &allocated);
+}
 
-    if (*headPtr == NULL) {
-        newNode->prev = NULL;
-        *headPtr = newNode;
-        return 1;
+// returns nodes a batch did not use to the allocator
+static void dll_release_nodes(dll_t *dll, void *chain) {
+    const la_allocator_t *allocator = dll->allocator;
+    void *node;
+    while ((node = la_chain_pop(&chain)) != NULL) {
+        allocator->free(allocator->ctx, node, sizeof(dll_node_t));
     }
+}
+
+static void *dll_free_node(dll_t *dll, dll_node_t *node) {
+    const la_allocator_t *allocator = dll->allocator;
+    void *data = node->data;
 
-    dll_node_t *ptr = *headPtr;
-    while(ptr->next != NULL) {
-        ptr = ptr->next;
+    dll->node_footprint -= allocator->footprint(allocator->ctx, node, sizeof(dll_node_t));
+    if (dll->payload_size != NULL) {
+        dll->payload_bytes -= dll->payload_size(data);
     }
 
-    ptr->next = newNode;
-    newNode->prev = ptr;
-    return 1;
+    allocator->free(allocator->ctx, node, sizeof(dll_node_t));
+    LS_COUNT(dll->stats.frees);
+    return data;
 }
 
-int dll_add_begin_node(void *data, dll_node_t **headPtr) {
-    dll_node_t *newNode = (dll_node_t *) malloc(sizeof(dll_node_t));
-    if (newNode == NULL) {
-        return 0;
+// links a node between two neighbours, either may be NULL at an end
+static void dll_link(dll_t *dll, dll_node_t *node, dll_node_t *prevNode, dll_node_t *nextNode) {
+    int p = DLL_PREV(dll);
+    int n = DLL_NEXT(dll);
+    node->link[p] = prevNode;
+    node->link[n] = nextNode;
+    if (prevNode != NULL) {
+        prevNode->link[n] = node;
+    } else {
+        dll->end[p] = node;
+    }
+    if (nextNode != NULL) {
+        nextNode->link[p] = node;
+    } else {
+        dll->end[n] = node;
+    }
+    dll->length++;
+}
+
+// unlinks a node and frees it
+static void *dll_unlink(dll_t *dll, dll_node_t *node) {
+    // the order does not matter here, the same code unlinks in both directions
+    for (int side = 0; side < 2; ++side) {
+        if (node->link[side] != NULL) {
+            node->link[side]->link[1 - side] = node->link[1 - side];
+        } else {
+            dll->end[side] = node->link[1 - side];
+        }
     }
+    dll->length--;
 
-    newNode->prev = NULL;
-    newNode->data = data;
+    return dll_free_node(dll, node);
+}
 
-    if (*headPtr == NULL) {
-        newNode->next = NULL;
-        *headPtr = newNode;
-        return 1;
+// the node at a position in [0, length), walked to from the nearer end
+static dll_node_t *dll_node_at(dll_t *dll, int pos) {
+    int p = DLL_PREV(dll);
+    int n = DLL_NEXT(dll);
+    dll_node_t *ptr;
+    if (pos <= dll->length / 2) {
+        ptr = dll->end[p];
+        for (int i = 0; i < pos; ++i) {
+            ptr = ptr->link[n];
+        }
+        LS_ADD(dll->walked, pos);
+    } else {
+        ptr = dll->end[n];
+        for (int i = dll->length - 1; i > pos; --i) {
+            ptr = ptr->link[p];
+        }
+        LS_ADD(dll->walked, dll->length - 1 - pos);
     }
+    return ptr;
+}
 
-    newNode->next = *headPtr;
-    (*headPtr)->prev = newNode;
-    *headPtr = newNode;
-    return 1;
+dll_t *dll_create_linked_list(void) {
+    dll_t *dll = (dll_t *) malloc(sizeof(dll_t));
+    if (dll == NULL) {
+        return NULL;
+    }
+
+    dll->length         = 0;
+    dll->end[0]         = NULL;
+    dll->end[1]         = NULL;
+    dll->reversed       = 0;
+    dll->allocator      = &dll->pool.allocator;
+    dll->payload_size   = NULL;
+    dll->node_footprint = 0;
+    dll->payload_bytes  = 0;
+    la_pool_init(&dll->pool, sizeof(dll_node_t));
+#ifdef CLIBSTRUCT_STATS
+    memset(&dll->stats, 0, sizeof(dll->stats));
+    dll->walked = 0;
+#endif
+    return dll;
 }
 
-int dll_insert_node(int pos, void *data, dll_node_t **headPtr) {
-    // lower bound check
-    if (pos < 0) {
+static int dll_add_end(void *data, dll_t *dll) {
+    dll_node_t *newNode = dll_alloc_node(dll, data);
+    if (newNode == NULL) {
         return 0;
     }
 
-    // insert at begining and to an empty list
-    if (pos == 0) { 
-        return dll_add_begin_node(data, headPtr);
-    }
+    dll_link(dll, newNode, dll->end[DLL_NEXT(dll)], NULL);
+    return 1;
+}
 
-    // for an empty list can't insert to a pos > 0
-    if (pos > 0 && *headPtr == NULL) {
+static int dll_add_begin(void *data, dll_t *dll) {
+    dll_node_t *newNode = dll_alloc_node(dll, data);
+    if (newNode == NULL) {
         return 0;
     }
 
-    int size = dll_size_linked_list(*headPtr);
+    dll_link(dll, newNode, NULL, dll->end[DLL_PREV(dll)]);
+    return 1;
+}
 
-    // upper bound check
-    if (pos > size) {
+static int dll_insert(int pos, void *data, dll_t *dll) {
+    // lower bound and upper bound check
+    if (pos < 0 || pos > dll->length) {
         return 0;
     }
 
-    // insert at given position
-    int count = 0;
-    dll_node_t *ptr = *headPtr;
-    dll_node_t *prevNode = NULL;
-    while (count != pos) {
-        prevNode = ptr;
-        ptr = ptr->next;
-        count++;
+    // insert at the end and to an empty list
+    if (pos == dll->length) {
+        return dll_add_end(data, dll);
     }
 
-    dll_node_t *newNode = (dll_node_t *) malloc(sizeof(dll_node_t));
+    dll_node_t *nextNode = dll_node_at(dll, pos);
+    dll_node_t *newNode = dll_alloc_node(dll, data);
     if (newNode == NULL) {
         return 0;
     }
 
-    prevNode->next = newNode;
-    newNode->prev  = prevNode;
-    newNode->data  = data;
-    newNode->next  = ptr;
-    ptr->prev      = newNode;
-
+    dll_link(dll, newNode, nextNode->link[DLL_PREV(dll)], nextNode);
     return 1;
-
 }
 
-void *dll_delete_end_node(dll_node_t **headPtr) {
+static void *dll_delete_end(dll_t *dll) {
     // empty check
-    if (*headPtr == NULL) {
+    if (dll->length == 0) {
         return NULL;
     }
 
-    // single node case
-    if ((*headPtr)->next == NULL) {
-        void *data = (*headPtr)->data;
-        free(*headPtr);
-        *headPtr = NULL;
-        return data;
+    return dll_unlink(dll, dll->end[DLL_NEXT(dll)]);
+}
+
+static void *dll_delete_begin(dll_t *dll) {
+    // empty check
+    if (dll->length == 0) {
+        return NULL;
     }
 
-    dll_node_t *ptr = *headPtr;
-    dll_node_t *prevNode = ptr;
+    return dll_unlink(dll, dll->end[DLL_PREV(dll)]);
+}
 
-    while (ptr->next != NULL) {
-        prevNode = ptr;
-        ptr = ptr->next;
+static void *dll_delete(int pos, dll_t *dll) {
+    // empty check, lower bound and upper bound check
+    if (pos < 0 || pos >= dll->length) {
+        return NULL;
     }
 
-    prevNode->next = NULL;
-    void *data = ptr->data;
-    free(ptr);
-
-    return data;
+    return dll_unlink(dll, dll_node_at(dll, pos));
 }
 
-void *dll_delete_begin_node(dll_node_t **headPtr) {
+static int dll_reverse(dll_t *dll) {
     // empty check
-    if (*headPtr == NULL) {
-        return NULL;
+    if (dll->length == 0) {
+        return 0;
     }
 
-    dll_node_t *tmp = *headPtr;
-    *headPtr = (*headPtr)->next;
-    (*headPtr)->prev = NULL;
-    void *data = tmp->data;
-    free(tmp);
-
-    return data;
+    // no node changes, the head and next links are read from the other side
+    dll->reversed = !dll->reversed;
+    return 1;
 }
 
-void *dll_delete_node(int pos, dll_node_t **headPtr) {
-    // empty check
-    if (*headPtr == NULL) {
-        return NULL;
+static int dll_rotate(int k, dll_t *dll) {
+    // empty check, lower bound and upper bound check
+    if (k < 0 || k >= dll->length) {
+        return 0;
     }
 
-    // lower bound check
-    if (pos < 0) {
-        return NULL;
+    if (k == 0) {
+        return 1;
     }
 
-    int size = dll_size_linked_list(*headPtr);
+    // close the ring, then cut it before the new head
+    int p = DLL_PREV(dll);
+    int n = DLL_NEXT(dll);
+    dll_node_t *newHead = dll_node_at(dll, k);
+    dll_node_t *newTail = newHead->link[p];
+    dll->end[n]->link[n] = dll->end[p];
+    dll->end[p]->link[p] = dll->end[n];
+    newTail->link[n] = NULL;
+    newHead->link[p] = NULL;
+    dll->end[p] = newHead;
+    dll->end[n] = newTail;
+    return 1;
+}
 
-    // upper bound check
-    if (pos >= size) {
-        return NULL;
+static int dll_partition(dll_pred_fn pred, void *ctx, dll_t *dll) {
+    // one pass, each node is appended to the matching or the other chain
+    dll_node_t *matchHead = NULL;
+    dll_node_t *matchTail = NULL;
+    dll_node_t *restHead = NULL;
+    dll_node_t *restTail = NULL;
+    int matched = 0;
+    int p = DLL_PREV(dll);
+    int n = DLL_NEXT(dll);
+
+    dll_node_t *ptr = dll->end[p];
+    while (ptr != NULL) {
+        dll_node_t *nextNode = ptr->link[n];
+        if (pred(ptr->data, ctx)) {
+            ptr->link[p] = matchTail;
+            if (matchTail != NULL) {
+                matchTail->link[n] = ptr;
+            } else {
+                matchHead = ptr;
+            }
+            matchTail = ptr;
+            matched++;
+        } else {
+            ptr->link[p] = restTail;
+            if (restTail != NULL) {
+                restTail->link[n] = ptr;
+            } else {
+                restHead = ptr;
+            }
+            restTail = ptr;
+        }
+        ptr = nextNode;
     }
+    LS_ADD(dll->walked, dll->length);
 
-    if (pos == 0) {
-        return dll_delete_begin_node(headPtr);
+    if (restTail != NULL) {
+        restTail->link[n] = NULL;
     }
-
-    int count = 0;
-    dll_node_t *ptr = *headPtr;
-    dll_node_t *prevPtr = ptr;
-    while (count != pos) {
-        count++;
-        prevPtr = ptr;
-        ptr = ptr->next;
+    if (matchTail == NULL) {
+        dll->end[p] = restHead;
+        dll->end[n] = restTail;
+        return 0;
     }
 
-    dll_node_t *tmp = ptr;
-    ptr = ptr->next;
-    prevPtr->next = ptr;
-    ptr->prev = prevPtr;
-    void *data = tmp->data;
-    free(tmp);
-
-    return data;
+    matchTail->link[n] = restHead;
+    if (restHead != NULL) {
+        restHead->link[p] = matchTail;
+    }
+    dll->end[p] = matchHead;
+    dll->end[n] = restTail != NULL ? restTail : matchTail;
+    return matched;
 }
 
-int dll_reverse_linked_list(dll_node_t **headPtr) {
+static int dll_dedup(dll_equal_fn equal, dll_release_fn release, void *ctx, dll_t *dll) {
     // empty check
-    if (*headPtr == NULL) {
+    if (dll->length == 0) {
         return 0;
     }
 
-    dll_node_t *ptr = *headPtr;
-    dll_node_t *prevNode = NULL;
-    dll_node_t *nextNode = ptr->next;
+    // keeps the first node of every run of equal data
+    int removed = 0;
+    int n = DLL_NEXT(dll);
+    dll_node_t *ptr = dll->end[DLL_PREV(dll)];
+    LS_ADD(dll->walked, dll->length);
+    while (ptr->link[n] != NULL) {
+        dll_node_t *nextNode = ptr->link[n];
+        bool same = equal != NULL ? equal(ptr->data, nextNode->data, ctx)
+                                  : ptr->data == nextNode->data;
+        if (!same) {
+            ptr = nextNode;
+            continue;
+        }
+
+        void *data = dll_unlink(dll, nextNode);
+        if (release != NULL) {
+            release(data, ctx);
+        }
+        removed++;
+    }
 
-    while (nextNode != NULL) {
-        ptr->prev = ptr->next;
-        ptr->next = prevNode;
-        prevNode = ptr;
-        ptr = nextNode;
-        nextNode = ptr->next;
+    return removed;
+}
+
+static int dll_insert_batch(const dll_insert_item_t *items, int count, int *status, dll_t *dll) {
+    // items behave like consecutive dll_insert_node calls, count the ones
+    // that will fit so all nodes can be allocated up front
+    int wanted = 0;
+    int length = dll->length;
+    int last_pos = 0;
+    for (int i = 0; i < count; ++i) {
+        if (items[i].pos >= last_pos && items[i].pos <= length) {
+            last_pos = items[i].pos;
+            length++;
+            wanted++;
+        }
     }
 
-    ptr->prev = ptr->next;
-    ptr->next = prevNode;
-    *headPtr = ptr;
-    return 1;
+    void *chain = dll_alloc_nodes(dll, wanted);
+
+    // one walk, positions never decrease
+    int success = 1;
+    int index = 0;
+    int p = DLL_PREV(dll);
+    int n = DLL_NEXT(dll);
+    dll_node_t *ptr = dll->end[p]; // the node at index, NULL past the end
+    last_pos = 0;
+    for (int i = 0; i < count; ++i) {
+        int pos = items[i].pos;
+        if (pos < last_pos || pos > dll->length || chain == NULL) {
+            if (status != NULL) {
+                status[i] = 0;
+            }
+            success = 0;
+            continue;
+        }
+
+        while (index < pos) {
+            ptr = ptr->link[n];
+            index++;
+        }
+
+        dll_node_t *newNode = la_chain_pop(&chain);
+        dll_init_node(dll, newNode, items[i].data);
+        dll_link(dll, newNode, ptr != NULL ? ptr->link[p] : dll->end[n], ptr);
+        ptr = newNode;
+
+        last_pos = pos;
+        if (status != NULL) {
+            status[i] = 1;
+        }
+    }
+    LS_ADD(dll->walked, index);
+
+    dll_release_nodes(dll, chain);
+    return success;
 }
 
-int dll_size_linked_list(dll_node_t *headPtr) {
-    // empty check
-    if (headPtr == NULL) {
-        return 0;
+static int dll_delete_batch(const int *positions, int count, void **data, int *status, dll_t *dll) {
+    int success = 1;
+    int deleted = 0;
+    int index = 0;
+    int last_pos = -1;
+    int n = DLL_NEXT(dll);
+    dll_node_t *ptr = dll->end[DLL_PREV(dll)];
+
+    for (int i = 0; i < count; ++i) {
+        // positions refer to the list before the batch and must increase
+        int pos = positions[i];
+        if (pos <= last_pos || pos >= dll->length + deleted) {
+            if (data != NULL) {
+                data[i] = NULL;
+            }
+            if (status != NULL) {
+                status[i] = 0;
+            }
+            success = 0;
+            continue;
+        }
+
+        while (index < pos - deleted) {
+            ptr = ptr->link[n];
+            index++;
+        }
+
+        dll_node_t *tmp = ptr;
+        ptr = ptr->link[n];
+        void *item = dll_unlink(dll, tmp);
+        deleted++;
+
+        last_pos = pos;
+        if (data != NULL) {
+            data[i] = item;
+        }
+        if (status != NULL) {
+            status[i] = 1;
+        }
     }
+    LS_ADD(dll->walked, index);
 
-    int count = 0;
-    dll_node_t *ptr = headPtr;
+    return success;
+}
 
-    while (ptr != NULL) {
-        count++;
-        ptr = ptr->next;
+static int dll_append_batch(void *const *data, int count, int *status, dll_t *dll) {
+    void *chain = dll_alloc_nodes(dll, count);
+
+    int success = 1;
+    for (int i = 0; i < count; ++i) {
+        if (chain == NULL) {
+            if (status != NULL) {
+                status[i] = 0;
+            }
+            success = 0;
+            continue;
+        }
+
+        dll_node_t *newNode = la_chain_pop(&chain);
+        dll_init_node(dll, newNode, data[i]);
+        dll_link(dll, newNode, dll->end[DLL_NEXT(dll)], NULL);
+
+        if (status != NULL) {
+            status[i] = 1;
+        }
     }
 
-    return count;
+    dll_release_nodes(dll, chain);
+    return success;
 }
 
-int dll_bytes_linked_list(dll_node_t *headPtr) { 
-    int numNodes = dll_size_linked_list(headPtr);
-    int bytesPerNode =  sizeof(dll_node_t);
-    return numNodes * bytesPerNode; 
+int dll_add_end_node(void *data, dll_t *dll) {
+    LS_TIMER_START(start);
+    int ret = dll_add_end(data, dll);
+    DLL_STATS_OP(dll, DLL_OP_ADD_END, start);
+    return ret;
 }
 
-void dll_print_node(dll_node_t *node) {
+int dll_add_begin_node(void *data, dll_t *dll) {
+    LS_TIMER_START(start);
+    int ret = dll_add_begin(data, dll);
+    DLL_STATS_OP(dll, DLL_OP_ADD_BEGIN, start);
+    return ret;
+}
+
+int dll_insert_node(int pos, void *data, dll_t *dll) {
+    LS_TIMER_START(start);
+    int ret = dll_insert(pos, data, dll);
+    DLL_STATS_OP(dll, DLL_OP_INSERT, start);
+    return ret;
+}
+
+void *dll_delete_end_node(dll_t *dll) {
+    LS_TIMER_START(start);
+    void *data = dll_delete_end(dll);
+    DLL_STATS_OP(dll, DLL_OP_DELETE_END, start);
+    return data;
+}
+
+void *dll_delete_begin_node(dll_t *dll) {
+    LS_TIMER_START(start);
+    void *data = dll_delete_begin(dll);
+    DLL_STATS_OP(dll, DLL_OP_DELETE_BEGIN, start);
+    return data;
+}
+
+void *dll_delete_node(int pos, dll_t *dll) {
+    LS_TIMER_START(start);
+    void *data = dll_delete(pos, dll);
+    DLL_STATS_OP(dll, DLL_OP_DELETE, start);
+    return data;
+}
+
+int dll_reverse_linked_list(dll_t *dll) {
+    LS_TIMER_START(start);
+    int ret = dll_reverse(dll);
+    DLL_STATS_OP(dll, DLL_OP_REVERSE, start);
+    return ret;
+}
+
+int dll_rotate_linked_list(int k, dll_t *dll) {
+    LS_TIMER_START(start);
+    int ret = dll_rotate(k, dll);
+    DLL_STATS_OP(dll, DLL_OP_ROTATE, start);
+    return ret;
+}
+
+int dll_partition_linked_list(dll_pred_fn pred, void *ctx, dll_t *dll) {
+    LS_TIMER_START(start);
+    int matched = dll_partition(pred, ctx, dll);
+    DLL_STATS_OP(dll, DLL_OP_PARTITION, start);
+    return matched;
+}
+
+int dll_dedup_linked_list(dll_equal_fn equal, dll_release_fn release, void *ctx, dll_t *dll) {
+    LS_TIMER_START(start);
+    int removed = dll_dedup(equal, release, ctx, dll);
+    DLL_STATS_OP(dll, DLL_OP_DEDUP, start);
+    return removed;
+}
+
+int dll_size_linked_list(dll_t *dll) {
+    LS_TIMER_START(start);
+    int size = dll->length;
+    DLL_STATS_OP(dll, DLL_OP_SIZE, start);
+    return size;
+}
+
+int dll_bytes_linked_list(dll_t *dll) {
+    LS_TIMER_START(start);
+    int bytes = dll->length * (int) sizeof(dll_node_t);
+    DLL_STATS_OP(dll, DLL_OP_BYTES, start);
+    return bytes;
+}
+
+int dll_insert_nodes(const dll_insert_item_t *items, int count, int *status, dll_t *dll) {
+    LS_TIMER_START(start);
+    int ret = dll_insert_batch(items, count, status, dll);
+    DLL_STATS_OP(dll, DLL_OP_INSERT_BATCH, start);
+    return ret;
+}
+
+int dll_delete_nodes(const int *positions, int count, void **data, int *status, dll_t *dll) {
+    LS_TIMER_START(start);
+    int ret = dll_delete_batch(positions, count, data, status, dll);
+    DLL_STATS_OP(dll, DLL_OP_DELETE_BATCH, start);
+    return ret;
+}
+
+int dll_append_nodes(void *const *data, int count, int *status, dll_t *dll) {
+    LS_TIMER_START(start);
+    int ret = dll_append_batch(data, count, status, dll);
+    DLL_STATS_OP(dll, DLL_OP_APPEND_BATCH, start);
+    return ret;
+}
+
+dll_node_t *dll_get_head(dll_t *dll) {
+    return dll->end[DLL_PREV(dll)];
+}
+
+dll_node_t *dll_get_tail(dll_t *dll) {
+    return dll->end[DLL_NEXT(dll)];
+}
+
+dll_node_t *dll_next_node(dll_node_t *node, dll_t *dll) {
+    return node->link[DLL_NEXT(dll)];
+}
+
+dll_node_t *dll_prev_node(dll_node_t *node, dll_t *dll) {
+    return node->link[DLL_PREV(dll)];
+}
+
+void *dll_node_data(dll_node_t *node) {
+    return node->data;
+}
+
+void dll_print_node(dll_node_t *node, dll_t *dll) {
     // empty check
     if (node == NULL) {
         return;
     }
 
-    printf("prev = %p | data = %p | next = %p\n", (void*)node->prev, node->data, (void*)node->next);
+    printf("prev = %p | data = %p | next = %p\n", (void*)dll_prev_node(node, dll), node->data, (void*)dll_next_node(node, dll));
 }
 
-void dll_print_linked_list(dll_node_t *headPtr) {
+void dll_print_linked_list(dll_t *dll) {
     // empty check
-    if (headPtr == NULL) {
+    if (dll->length == 0) {
         puts("<empty>");
         return;
     }
 
-    dll_node_t *ptr = headPtr;
+    dll_node_t *ptr = dll_get_head(dll);
 
     while (ptr != NULL) {
-        dll_print_node(ptr);
-        ptr = ptr->next;
+        dll_print_node(ptr, dll);
+        ptr = dll_next_node(ptr, dll);
+    }
+}
+
+void dll_destroy_linked_list(dll_t *dll) {
+    if (dll == NULL) {
+        return;
     }
+
+    // the data may already be freed, so the accounting is skipped and the
+    // payload callback never runs, the default pool frees its slabs at once
+    const la_allocator_t *allocator = dll->allocator;
+    if (allocator != &dll->pool.allocator) {
+        dll_node_t *ptr = dll->end[0];
+        while (ptr != NULL) {
+            dll_node_t *tmp = ptr;
+            ptr = ptr->link[1];
+            allocator->free(allocator->ctx, tmp, sizeof(dll_node_t));
+        }
+    }
+
+    la_pool_release(&dll->pool);
+    free(dll);
+}
+
+int dll_set_allocator(const la_allocator_t *allocator, dll_t *dll) {
+    // nodes must be freed by the allocator they came from
+    if (dll->length != 0) {
+        return 0;
+    }
+
+    // the list is empty, so the slabs of the default allocator are unused
+    if (allocator == NULL) {
+        allocator = &dll->pool.allocator;
+    } else if (allocator != &dll->pool.allocator) {
+        la_pool_release(&dll->pool);
+    }
+    dll->allocator = allocator;
+    return 1;
+}
+
+void dll_set_payload_size(la_size_fn payload_size, dll_t *dll) {
+    dll->payload_size  = payload_size;
+    dll->payload_bytes = 0;
+
+    if (payload_size == NULL) {
+        return;
+    }
+
+    // account for the nodes already in the list
+    dll_node_t *ptr = dll->end[0];
+    while (ptr != NULL) {
+        dll->payload_bytes += payload_size(ptr->data);
+        ptr = ptr->link[1];
+    }
+}
+
+int dll_trim_linked_list(dll_t *dll) {
+    // other allocators manage their own memory
+    if (dll->allocator != &dll->pool.allocator) {
+        return 1;
+    }
+
+    return la_pool_trim(&dll->pool);
+}
+
+void dll_memory_usage(la_usage_t *usage, dll_t *dll) {
+    const la_allocator_t *header_allocator = la_malloc_allocator();
+    size_t header_footprint = header_allocator->footprint(header_allocator->ctx, dll, sizeof(dll_t));
+    // slab space of the default allocator not taken by nodes
+    size_t idle_bytes = la_pool_idle_bytes(&dll->pool);
+
+    usage->nodes           = (size_t) dll->length;
+    usage->node_bytes      = usage->nodes * sizeof(dll_node_t);
+    usage->header_bytes    = sizeof(dll_t);
+    usage->allocator_bytes = (dll->node_footprint - usage->node_bytes) + (header_footprint - usage->header_bytes) + idle_bytes;
+    usage->payload_bytes   = dll->payload_bytes;
+    usage->total_bytes     = dll->node_footprint + header_footprint + idle_bytes + dll->payload_bytes;
+}
+
+int dll_get_stats(dll_stats_t *stats, dll_t *dll) {
+#ifdef CLIBSTRUCT_STATS
+    *stats = dll->stats;
+    return 1;
+#else
+    (void)stats;
+    (void)dll;
+    return 0;
+#endif
+}
+
+void dll_reset_stats(dll_t *dll) {
+#ifdef CLIBSTRUCT_STATS
+    memset(&dll->stats, 0, sizeof(dll->stats));
+    dll->walked = 0;
+#else
+    (void)dll;
+#endif
 }
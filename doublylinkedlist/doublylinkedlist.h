@@ -9,6 +9,11 @@
 #ifndef DOUBLYLINKEDLIST_H
 #define DOUBLYLINKEDLIST_H
 
+#include <stdbool.h>
+#include <stdint.h>
+#include "../liststats/liststats.h"
+#include "../listalloc/listalloc.h"
+
 /**
  * @addtogroup DoublyLinkedList
  * @{
@@ -16,102 +21,331 @@
 
 /**
  * @brief A node in a doubly linked list.
+ * @note Nodes are read through dll_next_node(), dll_prev_node() and
+ * dll_node_data(), as their neighbours depend on the direction of the list.
+ */
+typedef struct DllNode dll_node_t;
+
+/**
+ * @brief A doubly linked list structure.
+ */
+typedef struct Dll dll_t;
+
+/**
+ * @brief A position and data pair for dll_insert_nodes().
+ */
+typedef struct DllInsertItem {
+    int pos; /**< The position to insert the data at. */
+    void *data; /**< The data for the new node. */
+} dll_insert_item_t;
+
+/**
+ * @brief A predicate on the data of a node, for dll_partition_linked_list().
  */
-typedef struct DllNode {
-    struct DllNode *prev; /**< A pointer to the previous node in the list. */
-    struct DllNode *next; /**< A pointer to the next node in the list. */
-    void *data; /**< The data for the node. */
-} dll_node_t;
+typedef bool (*dll_pred_fn)(void *data, void *ctx);
 
 /**
- * @brief Creates a new linked list.
- * @param data The data for the first node.
- * @return A pointer to the head of the new linked list, or NULL on failure.
+ * @brief Compares the data of two nodes, for dll_dedup_linked_list().
  */
-dll_node_t *dll_create_linked_list(void *data);
+typedef bool (*dll_equal_fn)(void *a, void *b, void *ctx);
+
+/**
+ * @brief Receives the data of a node removed by dll_dedup_linked_list().
+ */
+typedef void (*dll_release_fn)(void *data, void *ctx);
+
+/**
+ * @brief The instrumented operations of a doubly linked list.
+ */
+typedef enum DllOp {
+    DLL_OP_ADD_END, /**< dll_add_end_node() */
+    DLL_OP_ADD_BEGIN, /**< dll_add_begin_node() */
+    DLL_OP_INSERT, /**< dll_insert_node() */
+    DLL_OP_DELETE_END, /**< dll_delete_end_node() */
+    DLL_OP_DELETE_BEGIN, /**< dll_delete_begin_node() */
+    DLL_OP_DELETE, /**< dll_delete_node() */
+    DLL_OP_REVERSE, /**< dll_reverse_linked_list() */
+    DLL_OP_SIZE, /**< dll_size_linked_list() */
+    DLL_OP_BYTES, /**< dll_bytes_linked_list() */
+    DLL_OP_INSERT_BATCH, /**< dll_insert_nodes() */
+    DLL_OP_DELETE_BATCH, /**< dll_delete_nodes() */
+    DLL_OP_APPEND_BATCH, /**< dll_append_nodes() */
+    DLL_OP_ROTATE, /**< dll_rotate_linked_list() */
+    DLL_OP_PARTITION, /**< dll_partition_linked_list() */
+    DLL_OP_DEDUP, /**< dll_dedup_linked_list() */
+    DLL_OP_COUNT /**< The number of instrumented operations. */
+} dll_op_t;
+
+/**
+ * @brief Instrumentation counters of a doubly linked list.
+ * @note Only collected when the library is built with `CLIBSTRUCT_STATS`,
+ * latencies only with `CLIBSTRUCT_STATS_TIMING`.
+ */
+typedef struct DllStats {
+    uint64_t allocations; /**< The number of nodes allocated. */
+    uint64_t frees; /**< The number of nodes freed. */
+    uint64_t op_count[DLL_OP_COUNT]; /**< The number of calls per operation. */
+    uint64_t nodes_traversed[DLL_OP_COUNT]; /**< The number of nodes walked per operation. */
+    ls_histogram_t latency[DLL_OP_COUNT]; /**< The latency histogram per operation. */
+} dll_stats_t;
+
+/**
+ * @brief Creates a new, empty linked list.
+ * @return A pointer to the new linked list, or NULL on failure.
+ */
+dll_t *dll_create_linked_list(void);
+
+/**
+ * @brief Frees every node of the linked list and the list itself.
+ * @param dll A pointer to the linked list.
+ * @note The data stored in the nodes is not freed, nor passed to the payload
+ * size callback, so it may be freed before the list is destroyed.
+ */
+void dll_destroy_linked_list(dll_t *dll);
 
 /**
  * @brief Adds a new node to the end of the linked list.
  * @param data The data for the new node.
- * @param headPtr A pointer to the head of the linked list.
+ * @param dll A pointer to the linked list.
  * @return 1 on success, 0 on failure.
  */
-int dll_add_end_node(void *data, dll_node_t **headPtr);
+int dll_add_end_node(void *data, dll_t *dll);
 
 /**
  * @brief Adds a new node to the beginning of the linked list.
  * @param data The data for the new node.
- * @param headPtr A pointer to the head of the linked list.
+ * @param dll A pointer to the linked list.
  * @return 1 on success, 0 on failure.
  */
-int dll_add_begin_node(void *data, dll_node_t **headPtr);
+int dll_add_begin_node(void *data, dll_t *dll);
 
 /**
  * @brief Inserts a new node at a specific position in the linked list.
  * @param pos The position to insert the new node at.
  * @param data The data for the new node.
- * @param headPtr A pointer to the head of the linked list.
+ * @param dll A pointer to the linked list.
  * @return 1 on success, 0 on failure.
  */
-int dll_insert_node(int pos, void *data, dll_node_t **headPtr);
+int dll_insert_node(int pos, void *data, dll_t *dll);
+
+/**
+ * @brief Inserts several nodes in a single walk of the linked list.
+ * @param items The items to insert, sorted by position.
+ * @param count The number of items.
+ * @param status An array receiving 1 or 0 per item, or NULL.
+ * @param dll A pointer to the linked list.
+ * @return 1 if every item was inserted, 0 otherwise.
+ * @note The result equals calling dll_insert_node() for each item in order.
+ * An item fails if its position is out of range or below the previous
+ * inserted position. All nodes are requested from the allocator at once.
+ */
+int dll_insert_nodes(const dll_insert_item_t *items, int count, int *status, dll_t *dll);
+
+/**
+ * @brief Appends several nodes to the end of the linked list in a single walk.
+ * @param data The data for the new nodes, in order.
+ * @param count The number of nodes.
+ * @param status An array receiving 1 or 0 per node, or NULL.
+ * @param dll A pointer to the linked list.
+ * @return 1 if every node was appended, 0 otherwise.
+ */
+int dll_append_nodes(void *const *data, int count, int *status, dll_t *dll);
 
 /**
  * @brief Deletes the last node of the linked list.
- * @param headPtr A pointer to the head of the linked list.
+ * @param dll A pointer to the linked list.
  * @return A pointer to the data of the deleted node, or NULL on failure.
  * @note The caller is responsible for freeing the memory of the returned data.
  */
-void *dll_delete_end_node(dll_node_t **headPtr);
+void *dll_delete_end_node(dll_t *dll);
 
 /**
  * @brief Deletes the first node of the linked list.
- * @param headPtr A pointer to the head of the linked list.
+ * @param dll A pointer to the linked list.
  * @return A pointer to the data of the deleted node, or NULL on failure.
  * @note The caller is responsible for freeing the memory of the returned data.
  */
-void *dll_delete_begin_node(dll_node_t **headPtr);
+void *dll_delete_begin_node(dll_t *dll);
 
 /**
  * @brief Deletes a node at a specific position in the linked list.
  * @param pos The 0-based position of the node to delete.
- * @param headPtr A pointer to the head of the linked list.
+ * @param dll A pointer to the linked list.
  * @return A pointer to the data of the deleted node, or NULL on failure.
  * @note The caller is responsible for freeing the memory of the returned data.
  */
-void *dll_delete_node(int pos, dll_node_t **headPtr);
+void *dll_delete_node(int pos, dll_t *dll);
+
+/**
+ * @brief Deletes several nodes in a single walk of the linked list.
+ * @param positions The 0-based positions in the list before the call, strictly increasing.
+ * @param count The number of positions.
+ * @param data An array receiving the data of each deleted node, NULL on failure, or NULL.
+ * @param status An array receiving 1 or 0 per position, or NULL.
+ * @param dll A pointer to the linked list.
+ * @return 1 if every node was deleted, 0 otherwise.
+ * @note The caller is responsible for freeing the memory of the returned data.
+ */
+int dll_delete_nodes(const int *positions, int count, void **data, int *status, dll_t *dll);
 
 /**
  * @brief Reverses the order of the linked list.
- * @param headPtr A pointer to the head of the linked list.
+ * @param dll A pointer to the linked list.
+ * @return 1 on success, 0 on failure.
+ * @note O(1), the list flips its direction and no node is touched.
+ */
+int dll_reverse_linked_list(dll_t *dll);
+
+/**
+ * @brief Rotates the linked list so the node at a position becomes the head.
+ * @param k The 0-based position of the new head, in [0, size).
+ * @param dll A pointer to the linked list.
  * @return 1 on success, 0 on failure.
+ * @note Walks to the new head from the nearer end, so this is
+ * O(min(k, size - k)). Only four links change, nodes are neither allocated
+ * nor freed.
  */
-int dll_reverse_linked_list(dll_node_t **headPtr);
+int dll_rotate_linked_list(int k, dll_t *dll);
+
+/**
+ * @brief Moves the nodes whose data satisfies a predicate to the front.
+ * @param pred The predicate.
+ * @param ctx A pointer passed to the predicate.
+ * @param dll A pointer to the linked list.
+ * @return The number of nodes that satisfied the predicate.
+ * @note Stable for both groups. Relinks the nodes in one walk without
+ * allocating.
+ */
+int dll_partition_linked_list(dll_pred_fn pred, void *ctx, dll_t *dll);
+
+/**
+ * @brief Deletes all but the first node of every run of equal data.
+ * @param equal The comparison, or NULL to compare the data pointers.
+ * @param release A callback receiving the data of each deleted node, or NULL.
+ * @param ctx A pointer passed to the callbacks.
+ * @param dll A pointer to the linked list.
+ * @return The number of nodes deleted.
+ * @note Removes every duplicate of a sorted list in one walk.
+ */
+int dll_dedup_linked_list(dll_equal_fn equal, dll_release_fn release, void *ctx, dll_t *dll);
 
 /**
  * @brief Gets the size of the linked list.
- * @param headPtr A pointer to the head of the linked list.
+ * @param dll A pointer to the linked list.
  * @return The number of nodes in the linked list.
+ * @note The length is kept in the list, so this is O(1).
  */
-int dll_size_linked_list(dll_node_t *headPtr);
+int dll_size_linked_list(dll_t *dll);
 
 /**
  * @brief Gets the number of bytes occupied by the linked list.
- * @param headPtr A pointer to the head of the linked list.
- * @return The number of bytes occupied by the linked list.
+ * @param dll A pointer to the linked list.
+ * @return The number of bytes occupied by the node structures of the linked list.
+ * @note This ignores allocator overhead, see dll_memory_usage() for a
+ * breakdown.
  */
-int dll_bytes_linked_list(dll_node_t *headPtr);
+int dll_bytes_linked_list(dll_t *dll);
 
 /**
  * @brief Prints a single node.
  * @param node A pointer to the node to print.
+ * @param dll A pointer to the linked list holding the node.
  */
-void dll_print_node(dll_node_t *node);
+void dll_print_node(dll_node_t *node, dll_t *dll);
 
 /**
  * @brief Prints the entire linked list.
- * @param head A pointer to the head of the linked list.
+ * @param dll A pointer to the linked list.
+ */
+void dll_print_linked_list(dll_t *dll);
+
+/**
+ * @brief Gets the first node of the linked list.
+ * @param dll A pointer to the linked list.
+ * @return A pointer to the first node, or NULL if the list is empty.
+ */
+dll_node_t *dll_get_head(dll_t *dll);
+
+/**
+ * @brief Gets the last node of the linked list.
+ * @param dll A pointer to the linked list.
+ * @return A pointer to the last node, or NULL if the list is empty.
+ */
+dll_node_t *dll_get_tail(dll_t *dll);
+
+/**
+ * @brief Gets the node after a node of the linked list.
+ * @param node A pointer to a node of the linked list.
+ * @param dll A pointer to the linked list holding the node.
+ * @return A pointer to the next node, or NULL if node is the tail.
+ */
+dll_node_t *dll_next_node(dll_node_t *node, dll_t *dll);
+
+/**
+ * @brief Gets the node before a node of the linked list.
+ * @param node A pointer to a node of the linked list.
+ * @param dll A pointer to the linked list holding the node.
+ * @return A pointer to the previous node, or NULL if node is the head.
+ */
+dll_node_t *dll_prev_node(dll_node_t *node, dll_t *dll);
+
+/**
+ * @brief Gets the data of a node.
+ * @param node A pointer to the node.
+ * @return The data stored in the node.
+ */
+void *dll_node_data(dll_node_t *node);
+
+/**
+ * @brief Sets the allocator used for the nodes of the linked list.
+ * @param allocator A pointer to the allocator, which must outlive the list, or NULL for the default.
+ * @param dll A pointer to the linked list.
+ * @return 1 on success, 0 if the list is not empty.
+ */
+int dll_set_allocator(const la_allocator_t *allocator, dll_t *dll);
+
+/**
+ * @brief Registers a callback reporting the payload size of the stored data.
+ * @param payload_size The callback, or NULL to stop tracking payload bytes.
+ * @param dll A pointer to the linked list.
+ * @note Registering walks the list once to account for the existing nodes.
+ * The data must not change size while it is stored in the list.
+ */
+void dll_set_payload_size(la_size_fn payload_size, dll_t *dll);
+
+/**
+ * @brief Returns the unused slabs of the default allocator to the system.
+ * @param dll A pointer to the linked list.
+ * @return 1 on success, 0 if the memory to index the slabs could not be allocated.
+ * @note The default allocator keeps freed nodes for reuse and gives its slabs
+ * back on its own only once the list is empty. This frees every slab without
+ * a node in use in O(f log s) for f free nodes and s slabs. Does nothing for
+ * an allocator set with dll_set_allocator().
+ */
+int dll_trim_linked_list(dll_t *dll);
+
+/**
+ * @brief Gets the memory used by the linked list in O(1).
+ * @param usage A pointer to the structure receiving the breakdown.
+ * @param dll A pointer to the linked list.
+ * @note Slab space the default allocator keeps for reuse counts as allocator
+ * bytes, see dll_trim_linked_list().
+ */
+void dll_memory_usage(la_usage_t *usage, dll_t *dll);
+
+/**
+ * @brief Gets the instrumentation counters of the linked list.
+ * @param stats A pointer to the structure receiving the counters.
+ * @param dll A pointer to the linked list.
+ * @return 1 on success, 0 if the library was built without `CLIBSTRUCT_STATS`.
+ */
+int dll_get_stats(dll_stats_t *stats, dll_t *dll);
+
+/**
+ * @brief Resets the instrumentation counters of the linked list.
+ * @param dll A pointer to the linked list.
  */
-void dll_print_linked_list(dll_node_t *head);
+void dll_reset_stats(dll_t *dll);
 
 /** @} */
 
@@ -0,0 +1,183 @@
+#define _POSIX_C_SOURCE 200809L
+#include "threadpool.h"
+#include "../workstealingdeque/workstealingdeque.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+
+typedef struct TpWorker {
+    tp_pool_t *pool;
+    int id;
+    unsigned int seed;
+    wsd_t *deque;
+    pthread_t thread;
+} tp_worker_t;
+
+typedef struct TpPool {
+    int num_threads;
+    tp_worker_t *workers;
+    _Atomic(tp_task_t *) injected;
+    atomic_int shutdown;
+} tp_pool_t;
+
+// worker running on the current thread, NULL outside the pool
+static _Thread_local tp_worker_t *current_worker = NULL;
+
+void tp_init_task(tp_task_t *task, tp_task_fn fn, void *arg) {
+    task->fn = fn;
+    task->arg = arg;
+    atomic_init(&task->done, 0);
+}
+
+static void tp_execute(tp_task_t *task) {
+    task->fn(task->arg);
+    atomic_store_explicit(&task->done, 1, memory_order_release);
+}
+
+static tp_task_t *tp_find_task(tp_worker_t *worker) {
+    tp_pool_t *pool = worker->pool;
+
+    // own work first, newest task is the hottest in cache
+    tp_task_t *task = wsd_pop_bottom(worker->deque);
+    if (task != NULL) {
+        return task;
+    }
+
+    // steal the oldest task of a random victim
+    int start = rand_r(&worker->seed) % pool->num_threads;
+    for (int i = 0; i < pool->num_threads; ++i) {
+        tp_worker_t *victim = &pool->workers[(start + i) % pool->num_threads];
+        if (victim == worker) {
+            continue;
+        }
+
+        task = wsd_steal(victim->deque);
+        if (task != NULL) {
+            return task;
+        }
+    }
+
+    // root task submitted from outside the pool
+    task = atomic_load_explicit(&pool->injected, memory_order_acquire);
+    if (task != NULL && atomic_compare_exchange_strong(&pool->injected, &task, NULL)) {
+        return task;
+    }
+
+    return NULL;
+}
+
+static void *tp_worker_main(void *arg) {
+    tp_worker_t *worker = (tp_worker_t *) arg;
+    current_worker = worker;
+
+    while (!atomic_load_explicit(&worker->pool->shutdown, memory_order_acquire)) {
+        tp_task_t *task = tp_find_task(worker);
+        if (task != NULL) {
+            tp_execute(task);
+        } else {
+            sched_yield();
+        }
+    }
+
+    return NULL;
+}
+
+static void tp_free_pool(tp_pool_t *pool) {
+    for (int i = 0; i < pool->num_threads; ++i) {
+        wsd_destroy_deque(pool->workers[i].deque);
+    }
+
+    free(pool->workers);
+    free(pool);
+}
+
+tp_pool_t *tp_create_pool(int num_threads) {
+    if (num_threads < 1) {
+        return NULL;
+    }
+
+    tp_pool_t *pool = (tp_pool_t *) malloc(sizeof(tp_pool_t));
+    if (pool == NULL) {
+        return NULL;
+    }
+
+    pool->workers = (tp_worker_t *) calloc(num_threads, sizeof(tp_worker_t));
+    if (pool->workers == NULL) {
+        free(pool);
+        return NULL;
+    }
+
+    pool->num_threads = num_threads;
+    atomic_init(&pool->injected, NULL);
+    atomic_init(&pool->shutdown, 0);
+
+    for (int i = 0; i < num_threads; ++i) {
+        tp_worker_t *worker = &pool->workers[i];
+        worker->pool = pool;
+        worker->id = i;
+        worker->seed = (unsigned int) i * 2654435761u + 1;
+        worker->deque = wsd_create_deque(64);
+        if (worker->deque == NULL) {
+            tp_free_pool(pool);
+            return NULL;
+        }
+    }
+
+    // start threads only once every deque exists, thieves scan all of them
+    for (int i = 0; i < num_threads; ++i) {
+        if (pthread_create(&pool->workers[i].thread, NULL, tp_worker_main, &pool->workers[i]) != 0) {
+            atomic_store(&pool->shutdown, 1);
+            for (int j = 0; j < i; ++j) {
+                pthread_join(pool->workers[j].thread, NULL);
+            }
+            tp_free_pool(pool);
+            return NULL;
+        }
+    }
+
+    return pool;
+}
+
+void tp_destroy_pool(tp_pool_t *pool) {
+    if (pool == NULL) {
+        return;
+    }
+
+    atomic_store(&pool->shutdown, 1);
+    for (int i = 0; i < pool->num_threads; ++i) {
+        pthread_join(pool->workers[i].thread, NULL);
+    }
+
+    tp_free_pool(pool);
+}
+
+void tp_run(tp_pool_t *pool, tp_task_t *task) {
+    // a single injection slot, wait for a previous root to be picked up
+    tp_task_t *expected = NULL;
+    while (!atomic_compare_exchange_weak(&pool->injected, &expected, task)) {
+        expected = NULL;
+        sched_yield();
+    }
+
+    while (!atomic_load_explicit(&task->done, memory_order_acquire)) {
+        sched_yield();
+    }
+}
+
+void tp_spawn(tp_task_t *task) {
+    // outside the pool or deque exhausted, run inline
+    if (current_worker == NULL || wsd_push_bottom(current_worker->deque, task) != 0) {
+        tp_execute(task);
+    }
+}
+
+void tp_wait(tp_task_t *task) {
+    while (!atomic_load_explicit(&task->done, memory_order_acquire)) {
+        tp_task_t *other = current_worker != NULL ? tp_find_task(current_worker) : NULL;
+        if (other != NULL) {
+            tp_execute(other);
+        } else {
+            sched_yield();
+        }
+    }
+}
@@ -0,0 +1,74 @@
+/**
+ * @file threadpool.h
+ * @brief A reference fork-join thread pool built on the work-stealing deque.
+ * @note Each worker owns a deque. Tasks spawned by a worker are pushed onto
+ * its own deque, idle workers steal from the top of a random victim, and a
+ * worker waiting on a child keeps executing other tasks until it completes.
+ * Tasks are owned by the caller, typically on the spawning task's stack.
+ */
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <stdatomic.h>
+
+/**
+ * @brief The function executed by a task.
+ */
+typedef void (*tp_task_fn)(void *arg);
+
+/**
+ * @brief A unit of work that can be spawned and waited on.
+ */
+typedef struct TpTask {
+    tp_task_fn fn; /**< The function to execute. */
+    void *arg; /**< The argument passed to the function. */
+    atomic_int done; /**< Set once the function has returned. */
+} tp_task_t;
+
+/**
+ * @brief A pool of worker threads.
+ */
+typedef struct TpPool tp_pool_t;
+
+/**
+ * @brief Initializes a task.
+ * @param task A pointer to the task.
+ * @param fn The function to execute.
+ * @param arg The argument passed to the function.
+ */
+void tp_init_task(tp_task_t *task, tp_task_fn fn, void *arg);
+
+/**
+ * @brief Creates a pool and starts its workers.
+ * @param num_threads The number of worker threads.
+ * @return A pointer to the new pool, or NULL on failure.
+ */
+tp_pool_t *tp_create_pool(int num_threads);
+
+/**
+ * @brief Stops the workers and destroys the pool.
+ * @param pool A pointer to the pool.
+ */
+void tp_destroy_pool(tp_pool_t *pool);
+
+/**
+ * @brief Submits a root task from outside the pool and blocks until it completes.
+ * @param pool A pointer to the pool.
+ * @param task A pointer to the task.
+ */
+void tp_run(tp_pool_t *pool, tp_task_t *task);
+
+/**
+ * @brief Spawns a child task from within a running task.
+ * @param task A pointer to the task.
+ * @note Outside a worker thread the task is executed immediately.
+ */
+void tp_spawn(tp_task_t *task);
+
+/**
+ * @brief Waits for a spawned task, executing other tasks in the meantime.
+ * @param task A pointer to the task.
+ */
+void tp_wait(tp_task_t *task);
+
+#endif // THREADPOOL_H
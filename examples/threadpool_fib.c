@@ -0,0 +1,62 @@
+/*
+ * Fork-join example: computes fib(n) recursively on the work-stealing
+ * thread pool.
+ *
+ * usage: threadpool_fib [n] [threads]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include "threadpool.h"
+
+// below this depth the work is too small to be worth spawning
+#define FIB_CUTOFF 16
+
+typedef struct {
+    tp_task_t task;
+    int n;
+    long result;
+} fib_t;
+
+static long fib_sequential(int n) {
+    return n < 2 ? n : fib_sequential(n - 1) + fib_sequential(n - 2);
+}
+
+static void fib_task(void *arg) {
+    fib_t *fib = (fib_t *) arg;
+    if (fib->n < FIB_CUTOFF) {
+        fib->result = fib_sequential(fib->n);
+        return;
+    }
+
+    // fork the first branch, compute the second one on this thread
+    fib_t left = { .n = fib->n - 1 };
+    tp_init_task(&left.task, fib_task, &left);
+    tp_spawn(&left.task);
+
+    fib_t right = { .n = fib->n - 2 };
+    fib_task(&right);
+
+    // join
+    tp_wait(&left.task);
+    fib->result = left.result + right.result;
+}
+
+int main(int argc, char **argv) {
+    int n = argc > 1 ? atoi(argv[1]) : 32;
+    int threads = argc > 2 ? atoi(argv[2]) : 4;
+
+    tp_pool_t *pool = tp_create_pool(threads);
+    if (pool == NULL) {
+        fprintf(stderr, "failed to create pool\n");
+        return 1;
+    }
+
+    fib_t root = { .n = n };
+    tp_init_task(&root.task, fib_task, &root);
+    tp_run(pool, &root.task);
+
+    printf("fib(%d) = %ld using %d threads\n", n, root.result, threads);
+
+    tp_destroy_pool(pool);
+    return root.result == fib_sequential(n) ? 0 : 1;
+}
@@ -0,0 +1,268 @@
+#define _POSIX_C_SOURCE 200809L
+#include "fuzz.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define FLAT_SMALL_SIZE 1000L
+#define FLAT_OPS 10000L
+#define FLAT_REPETITIONS 11
+
+static uint64_t fuzz_seed = 0;
+static uint64_t random_state = 0;
+static long fuzz_step = -1;
+
+static int fuzz_parse_long(const char *arg, const char *name, long *value) {
+    size_t len = strlen(name);
+    if (strncmp(arg, name, len) != 0 || arg[len] != '=') {
+        return 0;
+    }
+
+    char *end = NULL;
+    long parsed = strtol(arg + len + 1, &end, 10);
+    if (end == arg + len + 1 || *end != '\0' || parsed < 0) {
+        return -1;
+    }
+
+    *value = parsed;
+    return 1;
+}
+
+int fuzz_parse_args(fuzz_config_t *config, int argc, char **argv) {
+    config->seed       = 1;
+    config->ops        = 200000;
+    config->max_size   = 64;
+    config->large_size = 1000000;
+
+    for (int i = 1; i < argc; ++i) {
+        const char *arg = argv[i];
+        long value = 0;
+        int matched;
+
+        if ((matched = fuzz_parse_long(arg, "--seed", &value)) != 0) {
+            if (matched < 0) {
+                return 1;
+            }
+            config->seed = (uint64_t) value;
+        } else if ((matched = fuzz_parse_long(arg, "--ops", &value)) != 0) {
+            if (matched < 0) {
+                return 1;
+            }
+            config->ops = value;
+        } else if ((matched = fuzz_parse_long(arg, "--max-size", &value)) != 0) {
+            if (matched < 0 || value == 0) {
+                return 1;
+            }
+            config->max_size = (int) value;
+        } else if ((matched = fuzz_parse_long(arg, "--large-size", &value)) != 0) {
+            if (matched < 0) {
+                return 1;
+            }
+            config->large_size = value;
+        } else {
+            fprintf(stderr, "unknown option: %s\n", arg);
+            return 1;
+        }
+    }
+
+    // xorshift needs a non-zero state
+    fuzz_seed = config->seed;
+    random_state = config->seed * 0x9E3779B97F4A7C15ull + 1;
+    return 0;
+}
+
+void fuzz_set_step(long step) {
+    fuzz_step = step;
+}
+
+void fuzz_fail(const char *expr, const char *file, int line) {
+    fprintf(stderr, "%s:%d: check failed: %s (seed %llu, step %ld)\n",
+            file, line, expr, (unsigned long long) fuzz_seed, fuzz_step);
+    abort();
+}
+
+long fuzz_random(long bound) {
+    // xorshift64*
+    random_state ^= random_state >> 12;
+    random_state ^= random_state << 25;
+    random_state ^= random_state >> 27;
+    return (long) ((random_state * 2685821657736338717ull) % (uint64_t) bound);
+}
+
+int fuzz_model_init(fuzz_model_t *model, int capacity) {
+    model->items = (void **) malloc(capacity * sizeof(void *));
+    model->length = 0;
+    model->capacity = capacity;
+    return model->items == NULL ? 1 : 0;
+}
+
+void fuzz_model_free(fuzz_model_t *model) {
+    free(model->items);
+    model->items = NULL;
+    model->length = 0;
+    model->capacity = 0;
+}
+
+int fuzz_model_insert(fuzz_model_t *model, int pos, void *data) {
+    if (pos < 0 || pos > model->length || model->length == model->capacity) {
+        return 1;
+    }
+
+    memmove(&model->items[pos + 1], &model->items[pos], (model->length - pos) * sizeof(void *));
+    model->items[pos] = data;
+    model->length++;
+    return 0;
+}
+
+void *fuzz_model_delete(fuzz_model_t *model, int pos) {
+    if (pos < 0 || pos >= model->length) {
+        return NULL;
+    }
+
+    void *data = model->items[pos];
+    memmove(&model->items[pos], &model->items[pos + 1], (model->length - pos - 1) * sizeof(void *));
+    model->length--;
+    return data;
+}
+
+static void fuzz_model_reverse_range(void **items, int begin, int end) {
+    for (int i = begin, j = end - 1; i < j; ++i, --j) {
+        void *tmp = items[i];
+        items[i] = items[j];
+        items[j] = tmp;
+    }
+}
+
+void fuzz_model_reverse(fuzz_model_t *model) {
+    fuzz_model_reverse_range(model->items, 0, model->length);
+}
+
+int fuzz_model_rotate(fuzz_model_t *model, int k) {
+    if (k < 0 || k >= model->length) {
+        return 1;
+    }
+
+    fuzz_model_reverse_range(model->items, 0, k);
+    fuzz_model_reverse_range(model->items, k, model->length);
+    fuzz_model_reverse(model);
+    return 0;
+}
+
+int fuzz_model_partition(fuzz_model_t *model, bool (*pred)(void *data, void *ctx), void *ctx) {
+    // matching items are compacted in place, the others wait in a copy
+    int matched = 0;
+    int rest = 0;
+    void **spare = (void **) malloc((model->length + 1) * sizeof(void *));
+    FUZZ_CHECK(spare != NULL);
+    for (int i = 0; i < model->length; ++i) {
+        if (pred(model->items[i], ctx)) {
+            model->items[matched++] = model->items[i];
+        } else {
+            spare[rest++] = model->items[i];
+        }
+    }
+
+    memcpy(&model->items[matched], spare, rest * sizeof(void *));
+    free(spare);
+    return matched;
+}
+
+int fuzz_model_dedup(fuzz_model_t *model, bool (*equal)(void *a, void *b, void *ctx),
+                     void *ctx, void **removed) {
+    if (model->length == 0) {
+        return 0;
+    }
+
+    int kept = 1;
+    int count = 0;
+    for (int i = 1; i < model->length; ++i) {
+        void *last = model->items[kept - 1];
+        void *item = model->items[i];
+        if (equal != NULL ? equal(last, item, ctx) : last == item) {
+            removed[count++] = item;
+        } else {
+            model->items[kept++] = item;
+        }
+    }
+
+    model->length = kept;
+    return count;
+}
+
+void fuzz_model_insert_batch(fuzz_model_t *model, const int *positions,
+                             void *const *data, int count, int *status) {
+    int last_pos = 0;
+    for (int i = 0; i < count; ++i) {
+        if (positions[i] < last_pos || fuzz_model_insert(model, positions[i], data[i]) != 0) {
+            status[i] = 1;
+            continue;
+        }
+        last_pos = positions[i];
+        status[i] = 0;
+    }
+}
+
+void fuzz_model_delete_batch(fuzz_model_t *model, const int *positions, int count,
+                             void **data, int *status) {
+    int length = model->length;
+    int deleted = 0;
+    int last_pos = -1;
+    for (int i = 0; i < count; ++i) {
+        if (positions[i] <= last_pos || positions[i] >= length) {
+            data[i] = NULL;
+            status[i] = 1;
+            continue;
+        }
+        data[i] = fuzz_model_delete(model, positions[i] - deleted);
+        deleted++;
+        last_pos = positions[i];
+        status[i] = 0;
+    }
+}
+
+static uint64_t fuzz_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ull + (uint64_t) ts.tv_nsec;
+}
+
+static int fuzz_compare(const void *a, const void *b) {
+    double x = *(const double *) a;
+    double y = *(const double *) b;
+    return (x > y) - (x < y);
+}
+
+// median ns/op of FLAT_OPS operations on a list of the given size
+static double fuzz_time_ops(long size, fuzz_fn fill, fuzz_fn run, fuzz_fn clear, void *ctx) {
+    double samples[FLAT_REPETITIONS];
+
+    fill(ctx, size);
+    run(ctx, FLAT_OPS); // warmup
+    for (int i = 0; i < FLAT_REPETITIONS; ++i) {
+        uint64_t start = fuzz_now_ns();
+        run(ctx, FLAT_OPS);
+        samples[i] = (double) (fuzz_now_ns() - start) / FLAT_OPS;
+    }
+    clear(ctx, size);
+
+    qsort(samples, FLAT_REPETITIONS, sizeof(double), fuzz_compare);
+    return samples[FLAT_REPETITIONS / 2];
+}
+
+void fuzz_check_flat(const fuzz_config_t *config, const char *name,
+                     fuzz_fn fill, fuzz_fn run, fuzz_fn clear, void *ctx) {
+    if (config->large_size == 0) {
+        return;
+    }
+
+    double small = fuzz_time_ops(FLAT_SMALL_SIZE, fill, run, clear, ctx);
+    double large = fuzz_time_ops(config->large_size, fill, run, clear, ctx);
+    printf("%s: %.2f ns/op at %ld nodes, %.2f ns/op at %ld nodes\n",
+           name, small, FLAT_SMALL_SIZE, large, config->large_size);
+
+    // a sub-nanosecond baseline makes the ratio meaningless, compare against 1 ns
+    double baseline = small > 1.0 ? small : 1.0;
+    fuzz_set_step(-1);
+    FUZZ_CHECK(large <= baseline * FUZZ_FLAT_RATIO);
+}
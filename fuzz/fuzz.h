@@ -0,0 +1,196 @@
+/**
+ * @file fuzz.h
+ * @brief A small differential fuzzing harness shared by the list fuzz programs.
+ * @note A fuzz program replays a long random sequence of operations on a
+ * list and on a reference array model and checks after every step that both
+ * agree. A failed check prints the seed and step, so the sequence can be
+ * replayed with `--seed=N`. The harness also checks complexity bounds by
+ * timing constant time operations on a small and a large list and failing
+ * if the time per operation grows with the size.
+ */
+#ifndef FUZZ_H
+#define FUZZ_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @brief Settings shared by all checks of a fuzz program.
+ */
+typedef struct FuzzConfig {
+    uint64_t seed; /**< Seed of the operation sequence. */
+    long ops; /**< Number of random operations to replay. */
+    int max_size; /**< Largest list size the sequence grows to. */
+    long large_size; /**< Size of the large list of the complexity checks, 0 skips them. */
+} fuzz_config_t;
+
+/**
+ * @brief A reference list kept in a plain array.
+ */
+typedef struct FuzzModel {
+    void **items; /**< The items in list order. */
+    int length; /**< The number of items. */
+    int capacity; /**< The size of the items array. */
+} fuzz_model_t;
+
+/**
+ * @brief Runs a number of operations, or builds a list of a size.
+ * @param ctx The fuzz context.
+ * @param n The number of operations or the size.
+ */
+typedef void (*fuzz_fn)(void *ctx, long n);
+
+/**
+ * @brief Checks a condition and aborts with the seed and step if it is false.
+ */
+#define FUZZ_CHECK(cond) \
+    ((cond) ? (void)0 : fuzz_fail(#cond, __FILE__, __LINE__))
+
+/**
+ * @brief Parses the command line options and seeds the random sequence.
+ *
+ * Recognized options are `--seed=N`, `--ops=N`, `--max-size=N` and
+ * `--large-size=N`.
+ * @param config A pointer to the config, filled with defaults first.
+ * @param argc The argument count.
+ * @param argv The argument vector.
+ * @return 0 on success, 1 on an unknown or malformed option.
+ */
+int fuzz_parse_args(fuzz_config_t *config, int argc, char **argv);
+
+/**
+ * @brief Records the step being replayed, reported by a failed check.
+ * @param step The 0-based step.
+ */
+void fuzz_set_step(long step);
+
+/**
+ * @brief Reports a failed check and aborts.
+ * @param expr The text of the failed condition.
+ * @param file The source file of the check.
+ * @param line The source line of the check.
+ */
+void fuzz_fail(const char *expr, const char *file, int line);
+
+/**
+ * @brief Gets a pseudo random number from the seeded sequence.
+ * @param bound The exclusive upper bound, must be positive.
+ * @return A number in [0, bound).
+ */
+long fuzz_random(long bound);
+
+/**
+ * @brief Creates an empty model.
+ * @param model A pointer to the model.
+ * @param capacity The largest length the model will reach.
+ * @return 0 on success, 1 on failure.
+ */
+int fuzz_model_init(fuzz_model_t *model, int capacity);
+
+/**
+ * @brief Frees the storage of the model.
+ * @param model A pointer to the model.
+ */
+void fuzz_model_free(fuzz_model_t *model);
+
+/**
+ * @brief Inserts data so it ends up at a position.
+ * @param model A pointer to the model.
+ * @param pos The 0-based position, valid in [0, length].
+ * @param data The data to insert.
+ * @return 0 on success, 1 if the position is out of range or the model is full.
+ */
+int fuzz_model_insert(fuzz_model_t *model, int pos, void *data);
+
+/**
+ * @brief Deletes the item at a position.
+ * @param model A pointer to the model.
+ * @param pos The 0-based position, valid in [0, length).
+ * @return The deleted data, or NULL if the position is out of range.
+ */
+void *fuzz_model_delete(fuzz_model_t *model, int pos);
+
+/**
+ * @brief Reverses the order of the items.
+ * @param model A pointer to the model.
+ */
+void fuzz_model_reverse(fuzz_model_t *model);
+
+/**
+ * @brief Rotates the items so the item at a position comes first.
+ * @param model A pointer to the model.
+ * @param k The 0-based position, valid in [0, length).
+ * @return 0 on success, 1 if the position is out of range.
+ */
+int fuzz_model_rotate(fuzz_model_t *model, int k);
+
+/**
+ * @brief Moves the items satisfying a predicate to the front, keeping the order of both groups.
+ * @param model A pointer to the model.
+ * @param pred The predicate.
+ * @param ctx A pointer passed to the predicate.
+ * @return The number of items that satisfied the predicate.
+ */
+int fuzz_model_partition(fuzz_model_t *model, bool (*pred)(void *data, void *ctx), void *ctx);
+
+/**
+ * @brief Deletes all but the first item of every run of equal items.
+ * @param model A pointer to the model.
+ * @param equal The comparison, or NULL to compare the pointers.
+ * @param ctx A pointer passed to the comparison.
+ * @param removed An array receiving the deleted items in order.
+ * @return The number of items deleted.
+ */
+int fuzz_model_dedup(fuzz_model_t *model, bool (*equal)(void *a, void *b, void *ctx),
+                     void *ctx, void **removed);
+
+/**
+ * @brief Applies the batch insert rules of the list modules.
+ *
+ * Items are inserted in order, an item fails if its position is out of
+ * range or below the position of the previous inserted item.
+ * @param model A pointer to the model.
+ * @param positions The position of each item.
+ * @param data The data of each item.
+ * @param count The number of items.
+ * @param status An array receiving 0 or 1 per item.
+ */
+void fuzz_model_insert_batch(fuzz_model_t *model, const int *positions,
+                             void *const *data, int count, int *status);
+
+/**
+ * @brief Applies the batch delete rules of the list modules.
+ *
+ * Positions refer to the model before the batch, an item fails if its
+ * position is out of range or not above the previous deleted position.
+ * @param model A pointer to the model.
+ * @param positions The position of each item.
+ * @param count The number of items.
+ * @param data An array receiving the deleted data, NULL for failed items.
+ * @param status An array receiving 0 or 1 per item.
+ */
+void fuzz_model_delete_batch(fuzz_model_t *model, const int *positions, int count,
+                             void **data, int *status);
+
+/**
+ * @brief Fails unless the time per operation stays flat as the list grows.
+ *
+ * The operations are timed on a list of 1000 nodes and on a list of
+ * `config->large_size` nodes, the larger list may be at most
+ * FUZZ_FLAT_RATIO times slower per operation.
+ * @param config A pointer to the config.
+ * @param name The name of the operation, printed with the result.
+ * @param fill Builds a list of the given size.
+ * @param run Runs the given number of operations, leaving the size unchanged.
+ * @param clear Frees the list.
+ * @param ctx The fuzz context passed to the callbacks.
+ */
+void fuzz_check_flat(const fuzz_config_t *config, const char *name,
+                     fuzz_fn fill, fuzz_fn run, fuzz_fn clear, void *ctx);
+
+/**
+ * @brief The largest allowed slowdown per operation of fuzz_check_flat().
+ */
+#define FUZZ_FLAT_RATIO 4.0
+
+#endif // FUZZ_H
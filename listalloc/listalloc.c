@@ -0,0 +1,279 @@
+#include "listalloc.h"
+#include "listalloc_internal.h"
+#include <stdint.h>
+#include <stdlib.h>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+static void *la_malloc(void *ctx, size_t size) {
+    (void)ctx;
+    return malloc(size);
+}
+
+static void la_free(void *ctx, void *ptr, size_t size) {
+    (void)ctx;
+    (void)size;
+    free(ptr);
+}
+
+static size_t la_malloc_footprint(void *ctx, void *ptr, size_t size) {
+    (void)ctx;
+#ifdef __GLIBC__
+    (void)size;
+    // usable bytes plus the size word in front of the chunk
+    return malloc_usable_size(ptr) + sizeof(size_t);
+#else
+    (void)ptr;
+    size_t chunk = (size + sizeof(size_t) + 15) & ~(size_t)15;
+    return chunk < 32 ? 32 : chunk;
+#endif
+}
+
+static const la_allocator_t la_default = {
+    .alloc      = la_malloc,
+    .free       = la_free,
+    .footprint  = la_malloc_footprint,
+    .ctx        = NULL,
+    .alloc_many = NULL,
+};
+
+const la_allocator_t *la_malloc_allocator(void) {
+    return &la_default;
+}
+
+void *la_alloc_many(const la_allocator_t *allocator, size_t size, size_t count, size_t *allocated) {
+    if (allocator->alloc_many != NULL) {
+        return allocator->alloc_many(allocator->ctx, size, count, allocated);
+    }
+
+    // chain the blocks as they come, a failure keeps the ones already allocated
+    void *first = NULL;
+    void **link = &first;
+    size_t got = 0;
+    while (got < count) {
+        void *ptr = allocator->alloc(allocator->ctx, size);
+        if (ptr == NULL) {
+            break;
+        }
+        *link = ptr;
+        link = (void **) ptr;
+        got++;
+    }
+    *link = NULL;
+
+    *allocated = got;
+    return first;
+}
+
+// slabs are linked so the pool can free them, blocks follow the header
+struct LaSlab {
+    la_slab_t *next;
+    size_t blocks;
+    size_t idle; // free blocks, only counted by la_pool_trim
+};
+
+#define LA_SLAB_HEADER ((sizeof(la_slab_t) + sizeof(void *) - 1) / sizeof(void *) * sizeof(void *))
+
+// allocates a slab of blocks chained in address order, returns the first
+static void *la_pool_grow(la_pool_t *pool, size_t blocks) {
+    size_t bytes = LA_SLAB_HEADER + blocks * pool->stride;
+    la_slab_t *slab = (la_slab_t *) malloc(bytes);
+    if (slab == NULL) {
+        return NULL;
+    }
+
+    slab->next = pool->slabs;
+    slab->blocks = blocks;
+    pool->slabs = slab;
+    pool->slab_bytes += la_malloc_footprint(NULL, slab, bytes);
+    if (pool->next_blocks < LA_POOL_MAX_BLOCKS) {
+        pool->next_blocks *= 2;
+    }
+
+    unsigned char *block = (unsigned char *) slab + LA_SLAB_HEADER;
+    for (size_t i = 0; i + 1 < blocks; ++i) {
+        *(void **) (block + i * pool->stride) = block + (i + 1) * pool->stride;
+    }
+    *(void **) (block + (blocks - 1) * pool->stride) = NULL;
+    return block;
+}
+
+static void *la_pool_alloc(void *ctx, size_t size) {
+    la_pool_t *pool = ctx;
+    if (size > pool->stride) {
+        return NULL;
+    }
+
+    if (pool->free_list == NULL) {
+        pool->free_list = la_pool_grow(pool, pool->next_blocks);
+        if (pool->free_list == NULL) {
+            return NULL;
+        }
+    }
+
+    pool->in_use++;
+    return la_chain_pop(&pool->free_list);
+}
+
+static void la_pool_free(void *ctx, void *ptr, size_t size) {
+    la_pool_t *pool = ctx;
+    (void)size;
+    *(void **) ptr = pool->free_list;
+    pool->free_list = ptr;
+    pool->in_use--;
+
+    // the last block came back, give every slab back to malloc
+    if (pool->in_use == 0) {
+        la_pool_release(pool);
+    }
+}
+
+static size_t la_pool_footprint(void *ctx, void *ptr, size_t size) {
+    (void)ptr;
+    (void)size;
+    return ((la_pool_t *) ctx)->stride;
+}
+
+static void *la_pool_alloc_many(void *ctx, size_t size, size_t count, size_t *allocated) {
+    la_pool_t *pool = ctx;
+    *allocated = 0;
+    if (size > pool->stride || count == 0) {
+        return NULL;
+    }
+
+    // take what the free list has, then one slab for the rest
+    void *first = pool->free_list;
+    void **link = &first;
+    size_t got = 0;
+    while (got < count && *link != NULL) {
+        link = (void **) *link;
+        got++;
+    }
+    pool->free_list = *link;
+    *link = NULL;
+
+    if (got < count) {
+        size_t missing = count - got;
+        size_t blocks = missing > pool->next_blocks ? missing : pool->next_blocks;
+        void *chain = la_pool_grow(pool, blocks);
+        if (chain != NULL) {
+            *link = chain;
+            for (size_t i = 0; i < missing; ++i) {
+                link = (void **) *link;
+            }
+            pool->free_list = *link;
+            *link = NULL;
+            got = count;
+        }
+    }
+
+    pool->in_use += got;
+    *allocated = got;
+    return first;
+}
+
+void la_pool_init(la_pool_t *pool, size_t size) {
+    pool->allocator = (la_allocator_t) {
+        .alloc      = la_pool_alloc,
+        .free       = la_pool_free,
+        .footprint  = la_pool_footprint,
+        .ctx        = pool,
+        .alloc_many = la_pool_alloc_many,
+    };
+    // blocks hold pointers and link through their first word
+    size = size < sizeof(void *) ? sizeof(void *) : size;
+    pool->stride = (size + sizeof(void *) - 1) / sizeof(void *) * sizeof(void *);
+    pool->next_blocks = LA_POOL_MIN_BLOCKS;
+    pool->free_list = NULL;
+    pool->slabs = NULL;
+    pool->slab_bytes = 0;
+    pool->in_use = 0;
+}
+
+void la_pool_release(la_pool_t *pool) {
+    while (pool->slabs != NULL) {
+        la_slab_t *slab = pool->slabs;
+        pool->slabs = slab->next;
+        free(slab);
+    }
+
+    pool->next_blocks = LA_POOL_MIN_BLOCKS;
+    pool->free_list = NULL;
+    pool->slab_bytes = 0;
+}
+
+static int la_slab_compare(const void *a, const void *b) {
+    uintptr_t x = (uintptr_t) *(la_slab_t *const *) a;
+    uintptr_t y = (uintptr_t) *(la_slab_t *const *) b;
+    return (x > y) - (x < y);
+}
+
+// the slab holding a block, slabs sorted by address
+static la_slab_t *la_slab_find(la_slab_t **slabs, size_t count, void *block) {
+    size_t lo = 0;
+    size_t hi = count;
+    while (hi - lo > 1) {
+        size_t mid = lo + (hi - lo) / 2;
+        if ((uintptr_t) slabs[mid] <= (uintptr_t) block) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+    return slabs[lo];
+}
+
+int la_pool_trim(la_pool_t *pool) {
+    if (pool->in_use == 0) {
+        la_pool_release(pool);
+        return 1;
+    }
+
+    size_t count = 0;
+    for (la_slab_t *slab = pool->slabs; slab != NULL; slab = slab->next) {
+        slab->idle = 0;
+        count++;
+    }
+    la_slab_t **slabs = (la_slab_t **) malloc(count * sizeof(la_slab_t *));
+    if (slabs == NULL) {
+        return 0;
+    }
+    count = 0;
+    for (la_slab_t *slab = pool->slabs; slab != NULL; slab = slab->next) {
+        slabs[count++] = slab;
+    }
+    qsort(slabs, count, sizeof(la_slab_t *), la_slab_compare);
+
+    // count the free blocks of every slab, then drop the blocks of empty ones
+    for (void *block = pool->free_list; block != NULL; block = *(void **) block) {
+        la_slab_find(slabs, count, block)->idle++;
+    }
+    void **link = &pool->free_list;
+    while (*link != NULL) {
+        la_slab_t *slab = la_slab_find(slabs, count, *link);
+        if (slab->idle == slab->blocks) {
+            *link = *(void **) *link;
+        } else {
+            link = (void **) *link;
+        }
+    }
+    free(slabs);
+
+    la_slab_t **prev = &pool->slabs;
+    while (*prev != NULL) {
+        la_slab_t *slab = *prev;
+        if (slab->idle != slab->blocks) {
+            prev = &slab->next;
+            continue;
+        }
+        *prev = slab->next;
+        pool->slab_bytes -= la_malloc_footprint(NULL, slab, LA_SLAB_HEADER + slab->blocks * pool->stride);
+        free(slab);
+    }
+    return 1;
+}
+
+size_t la_pool_idle_bytes(const la_pool_t *pool) {
+    return pool->slab_bytes - pool->in_use * pool->stride;
+}
@@ -0,0 +1,73 @@
+/**
+ * @file listalloc.h
+ * @brief Pluggable node allocators and memory accounting for the list modules.
+ * @note An allocator reports the footprint of every block it hands out, i.e.
+ * the bytes the block really occupies including allocator headers and
+ * rounding. The lists add and subtract these footprints as nodes come and go,
+ * which keeps their memory usage queries O(1) and accurate for any allocator.
+ */
+#ifndef LISTALLOC_H
+#define LISTALLOC_H
+
+#include <stddef.h>
+
+/**
+ * @addtogroup ListAlloc
+ * @{
+ */
+
+/**
+ * @brief A node allocator.
+ */
+typedef struct LaAllocator {
+    void *(*alloc)(void *ctx, size_t size); /**< Allocates a block of size bytes, NULL on failure. */
+    void (*free)(void *ctx, void *ptr, size_t size); /**< Frees a block allocated with the requested size. */
+    size_t (*footprint)(void *ctx, void *ptr, size_t size); /**< Gets the bytes a block occupies, including allocator overhead. */
+    void *ctx; /**< The context passed to every callback. */
+    void *(*alloc_many)(void *ctx, size_t size, size_t count, size_t *allocated); /**< Optionally allocates count blocks at once, see la_alloc_many(). */
+} la_allocator_t;
+
+/**
+ * @brief Gets the size of the data stored in a node.
+ * @param data The data of the node.
+ * @return The number of payload bytes owned by the data.
+ */
+typedef size_t (*la_size_fn)(void *data);
+
+/**
+ * @brief A breakdown of the memory used by a list.
+ */
+typedef struct LaUsage {
+    size_t nodes; /**< The number of nodes. */
+    size_t node_bytes; /**< The bytes of the node structures. */
+    size_t header_bytes; /**< The bytes of the list structure. */
+    size_t allocator_bytes; /**< The allocator overhead on top of node and header bytes. */
+    size_t payload_bytes; /**< The payload bytes, 0 without a size callback. */
+    size_t total_bytes; /**< The sum of all of the above. */
+} la_usage_t;
+
+/**
+ * @brief Gets the default allocator backed by malloc and free.
+ * @return A pointer to the allocator.
+ * @note The footprint uses malloc_usable_size on glibc and an estimate of a
+ * 16 byte aligned chunk with one word of header elsewhere.
+ */
+const la_allocator_t *la_malloc_allocator(void);
+
+/**
+ * @brief Allocates several blocks of the same size as a chain.
+ * @param allocator A pointer to the allocator.
+ * @param size The size of each block, at least `sizeof(void *)`.
+ * @param count The number of blocks.
+ * @param allocated A pointer receiving the number of blocks allocated, less than count on failure.
+ * @return The first block, or NULL if none was allocated.
+ * @note The first word of every block points to the next one and is NULL in
+ * the last, so no array is needed to hand the blocks over. Uses the
+ * allocator's alloc_many in a single call when it has one and falls back to
+ * one alloc per block otherwise.
+ */
+void *la_alloc_many(const la_allocator_t *allocator, size_t size, size_t count, size_t *allocated);
+
+/** @} */
+
+#endif // LISTALLOC_H
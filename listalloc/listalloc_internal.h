@@ -0,0 +1,46 @@
+// the slab pool the lists allocate their nodes from, not part of the public API
+#ifndef LISTALLOC_INTERNAL_H
+#define LISTALLOC_INTERNAL_H
+
+#include "listalloc.h"
+
+// the first and the largest number of blocks a pool grows by at once
+#define LA_POOL_MIN_BLOCKS 4
+#define LA_POOL_MAX_BLOCKS 4096
+
+typedef struct LaSlab la_slab_t;
+
+// hands out blocks of one size carved from slabs, a bulk request costs at
+// most one malloc, freed blocks are kept for reuse until the last one is freed
+// or the pool is trimmed
+typedef struct LaPool {
+    la_allocator_t allocator; // ctx points back to the pool
+    size_t stride;
+    size_t next_blocks; // blocks in the next slab
+    void *free_list; // linked through the first word of each block
+    la_slab_t *slabs;
+    size_t slab_bytes; // malloc footprint of all slabs
+    size_t in_use;
+} la_pool_t;
+
+void la_pool_init(la_pool_t *pool, size_t size);
+
+// frees every slab, all blocks must have been freed
+void la_pool_release(la_pool_t *pool);
+
+// frees the slabs with no block in use, 0 if it could not allocate its index
+int la_pool_trim(la_pool_t *pool);
+
+// the bytes the pool holds beyond the footprint of the blocks in use
+size_t la_pool_idle_bytes(const la_pool_t *pool);
+
+// takes the first block off a chain returned by la_alloc_many
+static inline void *la_chain_pop(void **chain) {
+    void *block = *chain;
+    if (block != NULL) {
+        *chain = *(void **) block;
+    }
+    return block;
+}
+
+#endif // LISTALLOC_INTERNAL_H
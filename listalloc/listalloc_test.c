@@ -0,0 +1,484 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "listalloc.h"
+#include "../singlylinkedlist/singlylinkedlist.h"
+#include "../doublylinkedlist/doublylinkedlist.h"
+
+// fixed-size pool handing out 64 byte slots from one chunk
+#define POOL_SLOT 64
+#define POOL_SLOTS 16
+
+typedef struct {
+    unsigned char chunk[POOL_SLOT * POOL_SLOTS];
+    void *free_list;
+    int in_use;
+    int bulk_requests;
+} pool_t;
+
+static void pool_init(pool_t *pool) {
+    pool->free_list = NULL;
+    pool->in_use = 0;
+    pool->bulk_requests = 0;
+    for (int i = POOL_SLOTS - 1; i >= 0; --i) {
+        void *slot = pool->chunk + i * POOL_SLOT;
+        *(void **) slot = pool->free_list;
+        pool->free_list = slot;
+    }
+}
+
+static void *pool_alloc(void *ctx, size_t size) {
+    pool_t *pool = ctx;
+    if (size > POOL_SLOT || pool->free_list == NULL) {
+        return NULL;
+    }
+    void *slot = pool->free_list;
+    pool->free_list = *(void **) slot;
+    pool->in_use++;
+    return slot;
+}
+
+static void pool_free(void *ctx, void *ptr, size_t size) {
+    pool_t *pool = ctx;
+    (void)size;
+    *(void **) ptr = pool->free_list;
+    pool->free_list = ptr;
+    pool->in_use--;
+}
+
+static void *pool_alloc_many(void *ctx, size_t size, size_t count, size_t *allocated) {
+    pool_t *pool = ctx;
+    pool->bulk_requests++;
+    void *first = NULL;
+    void **link = &first;
+    *allocated = 0;
+    while (*allocated < count) {
+        void *slot = pool_alloc(ctx, size);
+        if (slot == NULL) {
+            break;
+        }
+        *link = slot;
+        link = (void **) slot;
+        (*allocated)++;
+    }
+    *link = NULL;
+    return first;
+}
+
+static size_t pool_footprint(void *ctx, void *ptr, size_t size) {
+    (void)ctx;
+    (void)ptr;
+    (void)size;
+    return POOL_SLOT;
+}
+
+static size_t string_size(void *data) {
+    return strlen((const char *) data) + 1;
+}
+
+static int size_calls;
+
+static size_t counted_string_size(void *data) {
+    size_calls++;
+    return string_size(data);
+}
+
+static char *copy_string(const char *text) {
+    char *copy = (char *) malloc(strlen(text) + 1);
+    assert(copy != NULL);
+    return strcpy(copy, text);
+}
+
+void test_malloc_footprint() {
+    printf("Running test_malloc_footprint...\n");
+    const la_allocator_t *allocator = la_malloc_allocator();
+    void *ptr = allocator->alloc(allocator->ctx, 24);
+    assert(ptr != NULL);
+    size_t footprint = allocator->footprint(allocator->ctx, ptr, 24);
+    // at least the request plus one word of header
+    assert(footprint >= 24 + sizeof(size_t));
+    allocator->free(allocator->ctx, ptr, 24);
+    printf("Passed.\n");
+}
+
+void test_sll_memory_usage() {
+    printf("Running test_sll_memory_usage...\n");
+    sll_t *list = sll_create_linked_list();
+    la_usage_t usage;
+
+    sll_memory_usage(list, &usage);
+    assert(usage.nodes == 0);
+    assert(usage.node_bytes == 0);
+    assert(usage.header_bytes > 0);
+    assert(usage.payload_bytes == 0);
+    size_t empty_total = usage.total_bytes;
+
+    sll_add_head_node(list, "ab");
+    sll_add_tail_node(list, "cde");
+    sll_memory_usage(list, &usage);
+    assert(usage.nodes == 2);
+    assert(usage.node_bytes > 0 && usage.node_bytes % 2 == 0);
+    assert(usage.total_bytes == usage.node_bytes + usage.header_bytes + usage.allocator_bytes);
+
+    // payload of existing nodes is picked up on registration
+    sll_set_payload_size(list, string_size);
+    sll_memory_usage(list, &usage);
+    assert(usage.payload_bytes == 3 + 4);
+
+    sll_insert_node(list, 1, "f");
+    sll_memory_usage(list, &usage);
+    assert(usage.payload_bytes == 3 + 4 + 2);
+
+    sll_delete_tail_node(list);
+    sll_delete_node(list, 0);
+    sll_memory_usage(list, &usage);
+    assert(usage.nodes == 1);
+    assert(usage.payload_bytes == 2);
+
+    // the default allocator gives its slabs back once the list is empty
+    sll_delete_head_node(list);
+    sll_memory_usage(list, &usage);
+    assert(usage.nodes == 0);
+    assert(usage.total_bytes == empty_total);
+    sll_add_head_node(list, "g");
+    sll_memory_usage(list, &usage);
+    assert(usage.nodes == 1);
+    assert(usage.payload_bytes == 2);
+
+    sll_destroy_linked_list(list);
+    printf("Passed.\n");
+}
+
+void test_sll_pool_allocator() {
+    printf("Running test_sll_pool_allocator...\n");
+    pool_t pool;
+    pool_init(&pool);
+    la_allocator_t allocator = { pool_alloc, pool_free, pool_footprint, &pool, pool_alloc_many };
+
+    sll_t *list = sll_create_linked_list();
+    assert(sll_set_allocator(list, &allocator) == 0);
+
+    la_usage_t empty;
+    sll_memory_usage(list, &empty);
+
+    for (intptr_t i = 1; i <= 5; ++i) {
+        assert(sll_add_head_node(list, (void *)i) == 0);
+    }
+    assert(pool.in_use == 5);
+
+    // the allocator can't change under live nodes
+    assert(sll_set_allocator(list, la_malloc_allocator()) == 1);
+
+    la_usage_t usage;
+    sll_memory_usage(list, &usage);
+    assert(usage.nodes == 5);
+    // the pool's slot size is what the nodes really occupy
+    assert(usage.allocator_bytes - empty.allocator_bytes == 5 * POOL_SLOT - usage.node_bytes);
+    assert(usage.total_bytes - empty.total_bytes == 5 * POOL_SLOT);
+
+    // NULL goes back to the default allocator once the list is empty
+    assert(sll_set_allocator(list, NULL) == 1);
+    while (sll_get_length(list) > 0) {
+        sll_delete_head_node(list);
+    }
+    assert(pool.in_use == 0);
+    assert(sll_set_allocator(list, NULL) == 0);
+    assert(sll_add_head_node(list, (void *)1) == 0);
+    assert(pool.in_use == 0);
+
+    sll_destroy_linked_list(list);
+    printf("Passed.\n");
+}
+
+void test_dll_memory_usage() {
+    printf("Running test_dll_memory_usage...\n");
+    pool_t pool;
+    pool_init(&pool);
+    la_allocator_t allocator = { pool_alloc, pool_free, pool_footprint, &pool, pool_alloc_many };
+
+    dll_t *dll = dll_create_linked_list();
+    dll_t *other = dll_create_linked_list();
+    la_usage_t empty;
+    dll_memory_usage(&empty, dll);
+    assert(empty.nodes == 0);
+    assert(empty.header_bytes > 0);
+    assert(empty.total_bytes == empty.header_bytes + empty.allocator_bytes);
+
+    assert(dll_set_allocator(&allocator, dll) == 1);
+    dll_add_end_node("ab", dll);
+    dll_add_end_node("cde", dll);
+    dll_add_begin_node("f", dll);
+    dll_add_end_node("gh", other);
+    assert(pool.in_use == 3);
+
+    // payload of existing nodes is picked up on registration
+    dll_set_payload_size(string_size, dll);
+
+    // the allocator can't change under live nodes
+    assert(dll_set_allocator(NULL, dll) == 0);
+
+    // usage is kept per list
+    la_usage_t usage;
+    dll_memory_usage(&usage, dll);
+    assert(usage.nodes == 3);
+    assert(usage.node_bytes == (size_t) dll_bytes_linked_list(dll));
+    assert(usage.header_bytes == empty.header_bytes);
+    assert(usage.allocator_bytes - empty.allocator_bytes == 3 * POOL_SLOT - usage.node_bytes);
+    assert(usage.payload_bytes == 3 + 4 + 2);
+    assert(usage.total_bytes - empty.total_bytes == 3 * POOL_SLOT + 9);
+    dll_memory_usage(&usage, other);
+    assert(usage.nodes == 1);
+    assert(usage.payload_bytes == 0);
+
+    dll_delete_end_node(dll);
+    dll_memory_usage(&usage, dll);
+    assert(usage.nodes == 2);
+    assert(usage.payload_bytes == 3 + 2);
+
+    dll_delete_end_node(dll);
+    dll_delete_begin_node(dll);
+    assert(pool.in_use == 0);
+    dll_memory_usage(&usage, dll);
+    assert(usage.total_bytes == empty.total_bytes);
+    assert(dll_set_allocator(NULL, dll) == 1);
+
+    dll_destroy_linked_list(dll);
+    dll_destroy_linked_list(other);
+    printf("Passed.\n");
+}
+
+void test_default_pool() {
+    printf("Running test_default_pool...\n");
+    void *data[1000];
+    for (intptr_t i = 0; i < 1000; ++i) {
+        data[i] = (void *)(i + 1);
+    }
+
+    // a batch takes one slab, single inserts take slabs that grow
+    sll_t *list = sll_create_linked_list();
+    la_usage_t empty;
+    la_usage_t usage;
+    sll_memory_usage(list, &empty);
+    assert(empty.total_bytes == empty.header_bytes + empty.allocator_bytes);
+    assert(sll_append_nodes(list, data, 1000, NULL) == 0);
+    sll_memory_usage(list, &usage);
+    assert(usage.nodes == 1000);
+    assert(usage.allocator_bytes - empty.allocator_bytes < 64);
+    for (int i = 0; i < 100; ++i) {
+        assert(sll_add_head_node(list, data[i]) == 0);
+    }
+    assert(sll_get_length(list) == 1100);
+
+    // freed nodes are reused before the pool grows
+    int positions[500];
+    for (int i = 0; i < 500; ++i) {
+        positions[i] = 2 * i;
+    }
+    assert(sll_delete_nodes(list, positions, 500, NULL, NULL) == 0);
+    sll_memory_usage(list, &empty);
+    assert(sll_append_nodes(list, data, 500, NULL) == 0);
+    sll_memory_usage(list, &usage);
+    assert(usage.total_bytes == empty.total_bytes);
+    sll_destroy_linked_list(list);
+
+    // emptying the list frees every slab
+    dll_t *dll = dll_create_linked_list();
+    dll_memory_usage(&empty, dll);
+    assert(dll_append_nodes(data, 1000, NULL, dll) == 1);
+    for (int i = 0; i < 1000; ++i) {
+        assert(dll_delete_begin_node(dll) == data[i]);
+    }
+    dll_memory_usage(&usage, dll);
+    assert(usage.total_bytes == empty.total_bytes);
+    dll_destroy_linked_list(dll);
+    printf("Passed.\n");
+}
+
+void test_destroy_after_data() {
+    printf("Running test_destroy_after_data...\n");
+    const char *texts[] = { "ab", "cde", "f" };
+    char *data[3];
+
+    // the caller owns the data and may free it before destroying the list,
+    // once with the default pool and once with an allocator that walks the nodes
+    for (int round = 0; round < 2; ++round) {
+        sll_t *list = sll_create_linked_list();
+        dll_t *dll = dll_create_linked_list();
+        if (round == 1) {
+            assert(sll_set_allocator(list, la_malloc_allocator()) == 0);
+            assert(dll_set_allocator(la_malloc_allocator(), dll) == 1);
+        }
+        sll_set_payload_size(list, counted_string_size);
+        dll_set_payload_size(counted_string_size, dll);
+
+        for (int i = 0; i < 3; ++i) {
+            data[i] = copy_string(texts[i]);
+            assert(sll_add_tail_node(list, data[i]) == 0);
+            assert(dll_add_end_node(data[i], dll) == 1);
+        }
+        for (int i = 0; i < 3; ++i) {
+            free(data[i]);
+        }
+
+        size_calls = 0;
+        sll_destroy_linked_list(list);
+        dll_destroy_linked_list(dll);
+        assert(size_calls == 0);
+    }
+    printf("Passed.\n");
+}
+
+void test_trim() {
+    printf("Running test_trim...\n");
+    void *data[1000];
+    for (intptr_t i = 0; i < 1000; ++i) {
+        data[i] = (void *)(i + 1);
+    }
+    la_usage_t before;
+    la_usage_t after;
+
+    // the batch fills one slab, the single nodes go to later slabs
+    sll_t *list = sll_create_linked_list();
+    assert(sll_append_nodes(list, data, 1000, NULL) == 0);
+    for (int i = 0; i < 100; ++i) {
+        assert(sll_add_tail_node(list, data[i]) == 0);
+    }
+    for (int i = 0; i < 1000; ++i) {
+        assert(sll_delete_head_node(list) == data[i]);
+    }
+    sll_memory_usage(list, &before);
+    assert(sll_trim_linked_list(list) == 0);
+    sll_memory_usage(list, &after);
+    assert(after.nodes == 100);
+    assert(before.total_bytes - after.total_bytes >= 1000 * (after.node_bytes / 100));
+
+    // nothing is left to free, and the list keeps working
+    assert(sll_trim_linked_list(list) == 0);
+    sll_memory_usage(list, &before);
+    assert(before.total_bytes == after.total_bytes);
+    assert(sll_append_nodes(list, data, 1000, NULL) == 0);
+    assert(sll_get_length(list) == 1100);
+    assert(sll_delete_tail_node(list) == data[999]);
+    sll_destroy_linked_list(list);
+
+    dll_t *dll = dll_create_linked_list();
+    assert(dll_append_nodes(data, 1000, NULL, dll) == 1);
+    for (int i = 0; i < 100; ++i) {
+        assert(dll_add_begin_node(data[i], dll) == 1);
+    }
+    for (int i = 0; i < 1000; ++i) {
+        assert(dll_delete_end_node(dll) == data[999 - i]);
+    }
+    dll_memory_usage(&before, dll);
+    assert(dll_trim_linked_list(dll) == 1);
+    dll_memory_usage(&after, dll);
+    assert(after.nodes == 100);
+    assert(before.total_bytes - after.total_bytes >= 1000 * (after.node_bytes / 100));
+    assert(dll_get_head(dll) != NULL && dll_node_data(dll_get_head(dll)) == data[99]);
+    dll_destroy_linked_list(dll);
+
+    // allocators set by the caller are left alone
+    dll = dll_create_linked_list();
+    assert(dll_set_allocator(la_malloc_allocator(), dll) == 1);
+    assert(dll_add_end_node(data[0], dll) == 1);
+    assert(dll_trim_linked_list(dll) == 1);
+    dll_destroy_linked_list(dll);
+    printf("Passed.\n");
+}
+
+void test_alloc_many_chain() {
+    printf("Running test_alloc_many_chain...\n");
+    // malloc has no bulk entry point, so blocks are chained one by one
+    size_t allocated = 0;
+    void *chain = la_alloc_many(la_malloc_allocator(), 24, 10, &allocated);
+    assert(allocated == 10);
+    int count = 0;
+    while (chain != NULL) {
+        void *next = *(void **) chain;
+        la_malloc_allocator()->free(NULL, chain, 24);
+        chain = next;
+        count++;
+    }
+    assert(count == 10);
+
+    // a pool running dry hands back the blocks it has
+    pool_t pool;
+    pool_init(&pool);
+    la_allocator_t allocator = { pool_alloc, pool_free, pool_footprint, &pool, NULL };
+    chain = la_alloc_many(&allocator, 8, POOL_SLOTS + 5, &allocated);
+    assert(allocated == POOL_SLOTS);
+    assert(pool.in_use == POOL_SLOTS);
+    while (chain != NULL) {
+        void *next = *(void **) chain;
+        pool_free(&pool, chain, 8);
+        chain = next;
+    }
+    assert(pool.in_use == 0);
+    printf("Passed.\n");
+}
+
+void test_batch_allocation() {
+    printf("Running test_batch_allocation...\n");
+    pool_t pool;
+    pool_init(&pool);
+    la_allocator_t allocator = { pool_alloc, pool_free, pool_footprint, &pool, pool_alloc_many };
+
+    sll_t *list = sll_create_linked_list();
+    assert(sll_set_allocator(list, &allocator) == 0);
+
+    // one bulk request for the whole batch
+    void *data[20];
+    for (intptr_t i = 0; i < 20; ++i) {
+        data[i] = (void *)(i + 1);
+    }
+    int status[20];
+    assert(sll_append_nodes(list, data, 10, status) == 0);
+    assert(pool.bulk_requests == 1);
+    assert(pool.in_use == 10);
+
+    // the pool runs dry, the remaining items fail
+    assert(sll_append_nodes(list, data, 10, status) == 1);
+    assert(pool.bulk_requests == 2);
+    for (int i = 0; i < 10; ++i) {
+        assert(status[i] == (i < POOL_SLOTS - 10 ? 0 : 1));
+    }
+    assert(sll_get_length(list) == POOL_SLOTS);
+
+    sll_destroy_linked_list(list);
+    assert(pool.in_use == 0);
+
+    // the DLL only requests nodes for the items that fit
+    dll_t *dll = dll_create_linked_list();
+    assert(dll_set_allocator(&allocator, dll) == 1);
+    la_usage_t empty;
+    dll_memory_usage(&empty, dll);
+    dll_insert_item_t items[] = { { 0, (void *)1 }, { 99, (void *)2 } };
+    assert(dll_insert_nodes(items, 2, status, dll) == 0);
+    assert(status[0] == 1 && status[1] == 0);
+    assert(pool.bulk_requests == 3);
+    assert(pool.in_use == 1);
+
+    la_usage_t usage;
+    dll_memory_usage(&usage, dll);
+    assert(usage.nodes == 1);
+    assert(usage.total_bytes - empty.total_bytes == POOL_SLOT);
+
+    dll_destroy_linked_list(dll);
+    assert(pool.in_use == 0);
+    printf("Passed.\n");
+}
+
+int main(void) {
+    test_malloc_footprint();
+    test_alloc_many_chain();
+    test_sll_memory_usage();
+    test_sll_pool_allocator();
+    test_dll_memory_usage();
+    test_default_pool();
+    test_trim();
+    test_destroy_after_data();
+    test_batch_allocation();
+    printf("All tests passed successfully.\n");
+    return 0;
+}
@@ -0,0 +1,93 @@
+/**
+ * @file liststats.h
+ * @brief Opt-in operation counters and latency histograms for the list modules.
+ * @note Instrumentation is compiled in only when the library is built with
+ * `-DCLIBSTRUCT_STATS`, which counts allocations, frees, operations and the
+ * nodes each operation walks. `-DCLIBSTRUCT_STATS_TIMING` additionally records
+ * the latency of every operation into a histogram and implies
+ * `CLIBSTRUCT_STATS`. Without either flag the hooks compile to nothing and
+ * the list structures carry no extra fields.
+ */
+#ifndef LISTSTATS_H
+#define LISTSTATS_H
+
+#include <stdint.h>
+
+#if defined(CLIBSTRUCT_STATS_TIMING) && !defined(CLIBSTRUCT_STATS)
+#define CLIBSTRUCT_STATS
+#endif
+
+/**
+ * @addtogroup ListStats
+ * @{
+ */
+
+/**
+ * @brief Number of buckets in a latency histogram.
+ *
+ * Bucket 0 holds latencies below 1 ns, bucket i holds latencies in
+ * [2^(i-1), 2^i) ns and the last bucket holds everything above.
+ */
+#define LS_HISTOGRAM_BUCKETS 40
+
+/**
+ * @brief A log2 latency histogram.
+ */
+typedef struct LsHistogram {
+    uint64_t count; /**< The number of recorded latencies. */
+    uint64_t total_ns; /**< The sum of the recorded latencies. */
+    uint64_t max_ns; /**< The largest recorded latency. */
+    uint64_t buckets[LS_HISTOGRAM_BUCKETS]; /**< The number of latencies per bucket. */
+} ls_histogram_t;
+
+/**
+ * @brief Records a latency into a histogram.
+ * @param histogram A pointer to the histogram.
+ * @param ns The latency in nanoseconds.
+ */
+static inline void ls_histogram_record(ls_histogram_t *histogram, uint64_t ns) {
+    int bucket = 0;
+    while (ns >> bucket != 0 && bucket < LS_HISTOGRAM_BUCKETS - 1) {
+        bucket++;
+    }
+
+    histogram->count++;
+    histogram->total_ns += ns;
+    if (ns > histogram->max_ns) {
+        histogram->max_ns = ns;
+    }
+    histogram->buckets[bucket]++;
+}
+
+/**
+ * @brief Estimates a percentile of a histogram.
+ * @param histogram A pointer to the histogram.
+ * @param percentile The percentile in [0, 100].
+ * @return The upper bound in nanoseconds of the bucket holding the
+ * percentile, or 0 for an empty histogram.
+ */
+static inline uint64_t ls_histogram_percentile(const ls_histogram_t *histogram, double percentile) {
+    if (histogram->count == 0) {
+        return 0;
+    }
+
+    uint64_t rank = (uint64_t) (percentile / 100.0 * (double) histogram->count);
+    if (rank >= histogram->count) {
+        rank = histogram->count - 1;
+    }
+
+    uint64_t seen = 0;
+    for (int i = 0; i < LS_HISTOGRAM_BUCKETS - 1; ++i) {
+        seen += histogram->buckets[i];
+        if (seen > rank) {
+            uint64_t upper = (uint64_t) 1 << i;
+            return upper < histogram->max_ns ? upper : histogram->max_ns;
+        }
+    }
+
+    return histogram->max_ns;
+}
+
+/** @} */
+
+#endif // LISTSTATS_H
@@ -0,0 +1,31 @@
+// instrumentation hooks used by the list modules, not part of the public API
+#ifndef LISTSTATS_INTERNAL_H
+#define LISTSTATS_INTERNAL_H
+
+#include "liststats.h"
+
+#ifdef CLIBSTRUCT_STATS
+#define LS_COUNT(counter) ((counter)++)
+#define LS_ADD(counter, n) ((counter) += (uint64_t) (n))
+#else
+#define LS_COUNT(counter) ((void)0)
+#define LS_ADD(counter, n) ((void)0)
+#endif
+
+#ifdef CLIBSTRUCT_STATS_TIMING
+#include <time.h>
+
+static inline uint64_t ls_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ull + (uint64_t) ts.tv_nsec;
+}
+
+#define LS_TIMER_START(timer) uint64_t timer = ls_now_ns()
+#define LS_TIMER_RECORD(timer, histogram) ls_histogram_record(&(histogram), ls_now_ns() - (timer))
+#else
+#define LS_TIMER_START(timer) ((void)0)
+#define LS_TIMER_RECORD(timer, histogram) ((void)0)
+#endif
+
+#endif // LISTSTATS_INTERNAL_H
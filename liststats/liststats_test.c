@@ -0,0 +1,128 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include "liststats.h"
+#include "../singlylinkedlist/singlylinkedlist.h"
+#include "../doublylinkedlist/doublylinkedlist.h"
+
+#ifndef CLIBSTRUCT_STATS_TIMING
+#error "liststats_test must be built with -DCLIBSTRUCT_STATS_TIMING"
+#endif
+
+void test_histogram() {
+    printf("Running test_histogram...\n");
+    ls_histogram_t histogram = { 0 };
+    assert(ls_histogram_percentile(&histogram, 50) == 0);
+
+    for (int i = 0; i < 99; ++i) {
+        ls_histogram_record(&histogram, 100);
+    }
+    ls_histogram_record(&histogram, 5000);
+
+    assert(histogram.count == 100);
+    assert(histogram.total_ns == 99 * 100 + 5000);
+    assert(histogram.max_ns == 5000);
+    // 100 falls in [64, 128), 5000 in [4096, 8192)
+    assert(histogram.buckets[7] == 99);
+    assert(histogram.buckets[13] == 1);
+    assert(ls_histogram_percentile(&histogram, 50) == 128);
+    assert(ls_histogram_percentile(&histogram, 100) == 5000);
+    printf("Passed.\n");
+}
+
+void test_sll_stats() {
+    printf("Running test_sll_stats...\n");
+    sll_t *list = sll_create_linked_list();
+    sll_stats_t stats;
+
+    assert(sll_get_stats(list, &stats) == 0);
+    assert(stats.allocations == 0);
+
+    sll_add_head_node(list, (void *)1);
+    sll_add_head_node(list, (void *)2);
+    sll_add_head_node(list, (void *)3); // [3, 2, 1]
+    sll_insert_node(list, 2, (void *)4); // [3, 2, 4, 1]
+    sll_delete_tail_node(list); // [3, 2, 4]
+
+    assert(sll_get_stats(list, &stats) == 0);
+    assert(stats.allocations == 4);
+    assert(stats.frees == 1);
+    assert(stats.op_count[SLL_OP_ADD_HEAD] == 3);
+    assert(stats.op_count[SLL_OP_INSERT] == 1);
+    assert(stats.op_count[SLL_OP_DELETE_TAIL] == 1);
+    assert(stats.nodes_traversed[SLL_OP_ADD_HEAD] == 0);
+    assert(stats.nodes_traversed[SLL_OP_INSERT] == 1);
+    assert(stats.nodes_traversed[SLL_OP_DELETE_TAIL] == 2);
+    assert(stats.latency[SLL_OP_ADD_HEAD].count == 3);
+    assert(stats.latency[SLL_OP_INSERT].count == 1);
+
+    // internal calls are attributed to the public operation
+    sll_insert_node(list, 0, (void *)5);
+    assert(sll_get_stats(list, &stats) == 0);
+    assert(stats.op_count[SLL_OP_INSERT] == 2);
+    assert(stats.op_count[SLL_OP_ADD_HEAD] == 3);
+
+    sll_reset_stats(list);
+    assert(sll_get_stats(list, &stats) == 0);
+    assert(stats.allocations == 0);
+    assert(stats.op_count[SLL_OP_INSERT] == 0);
+    assert(stats.latency[SLL_OP_INSERT].count == 0);
+
+    sll_destroy_linked_list(list);
+    printf("Passed.\n");
+}
+
+void test_dll_stats() {
+    printf("Running test_dll_stats...\n");
+    dll_stats_t stats;
+
+    dll_t *dll = dll_create_linked_list();
+    dll_t *other = dll_create_linked_list();
+    dll_add_end_node((void *)1, dll);
+    dll_add_end_node((void *)2, dll);
+    dll_add_end_node((void *)3, dll); // [1, 2, 3]
+    dll_insert_node(2, (void *)4, dll); // [1, 2, 4, 3]
+    assert(dll_size_linked_list(dll) == 4);
+    dll_delete_end_node(dll); // [1, 2, 4]
+    dll_add_begin_node((void *)5, other);
+
+    assert(dll_get_stats(&stats, dll) == 1);
+    assert(stats.allocations == 4);
+    assert(stats.frees == 1);
+    assert(stats.op_count[DLL_OP_ADD_END] == 3);
+    assert(stats.op_count[DLL_OP_ADD_BEGIN] == 0);
+    assert(stats.nodes_traversed[DLL_OP_ADD_END] == 0);
+    // the position is reached from the nearer end
+    assert(stats.op_count[DLL_OP_INSERT] == 1);
+    assert(stats.nodes_traversed[DLL_OP_INSERT] == 0);
+    assert(stats.op_count[DLL_OP_SIZE] == 1);
+    assert(stats.nodes_traversed[DLL_OP_SIZE] == 0);
+    assert(stats.nodes_traversed[DLL_OP_DELETE_END] == 0);
+    assert(stats.latency[DLL_OP_SIZE].count == 1);
+
+    dll_delete_node(1, dll); // [1, 4]
+    assert(dll_get_stats(&stats, dll) == 1);
+    assert(stats.nodes_traversed[DLL_OP_DELETE] == 1);
+
+    // every list keeps its own counters
+    assert(dll_get_stats(&stats, other) == 1);
+    assert(stats.allocations == 1);
+    assert(stats.op_count[DLL_OP_ADD_BEGIN] == 1);
+    assert(stats.op_count[DLL_OP_ADD_END] == 0);
+
+    dll_reset_stats(dll);
+    assert(dll_get_stats(&stats, dll) == 1);
+    assert(stats.allocations == 0);
+
+    dll_destroy_linked_list(dll);
+    dll_destroy_linked_list(other);
+    printf("Passed.\n");
+}
+
+int main(void) {
+    test_histogram();
+    test_sll_stats();
+    test_dll_stats();
+    printf("All tests passed successfully.\n");
+    return 0;
+}
@@ -0,0 +1,104 @@
+/*
+ * Benchmarks for the node cache against malloc.
+ *
+ * - alloc/free pairs on one thread through the la_allocator_t interface
+ * - cross-thread produce/consume: a producer fills singly linked lists and
+ *   hands them over a channel, the benchmark thread drains and frees them
+ *
+ * usage: nc_bench [--format=csv|json] [--warmup=N] [--repetitions=N]
+ *                 [--filter=TEXT]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <pthread.h>
+#include "nodecache.h"
+#include "../singlylinkedlist/singlylinkedlist.h"
+#include "../channel/channel.h"
+#include "../bench/bench.h"
+
+#define BLOCK_SIZE 32
+#define CONSTANT_BATCH 1000L
+#define LIST_NODES 256
+#define LISTS 400L
+#define CHANNEL_CAPACITY 16
+
+typedef struct {
+    const la_allocator_t *allocator;
+    void *blocks[CONSTANT_BATCH];
+    chan_t *chan;
+    void *data[LIST_NODES];
+} nc_bench_t;
+
+static void run_alloc_free(void *ctx, long ops) {
+    nc_bench_t *b = ctx;
+    const la_allocator_t *allocator = b->allocator;
+    for (long i = 0; i < ops; ++i) {
+        b->blocks[i] = allocator->alloc(allocator->ctx, BLOCK_SIZE);
+    }
+    for (long i = ops - 1; i >= 0; --i) {
+        allocator->free(allocator->ctx, b->blocks[i], BLOCK_SIZE);
+    }
+}
+
+static void *producer(void *arg) {
+    nc_bench_t *b = arg;
+    for (long i = 0; i < LISTS; ++i) {
+        sll_t *list = sll_create_linked_list();
+        sll_set_allocator(list, b->allocator);
+        sll_append_nodes(list, b->data, LIST_NODES, NULL);
+        chan_send(b->chan, list);
+    }
+    return NULL;
+}
+
+// one op is a node allocated by the producer and freed by this thread
+static void run_produce_consume(void *ctx, long ops) {
+    nc_bench_t *b = ctx;
+    pthread_t thread;
+    (void)ops;
+
+    pthread_create(&thread, NULL, producer, b);
+    for (long i = 0; i < LISTS; ++i) {
+        void *list = NULL;
+        chan_recv(b->chan, &list);
+        while (sll_delete_head_node((sll_t *) list) != NULL) {
+        }
+        sll_destroy_linked_list((sll_t *) list);
+    }
+    pthread_join(thread, NULL);
+}
+
+int main(int argc, char **argv) {
+    bench_config_t config;
+    if (bench_parse_args(&config, argc, argv) != 0) {
+        return 1;
+    }
+
+    nc_bench_t b = { 0 };
+    for (intptr_t i = 0; i < LIST_NODES; ++i) {
+        b.data[i] = (void *) (i + 1);
+    }
+    b.chan = chan_create(CHANNEL_CAPACITY);
+    nc_cache_t *cache = nc_create_cache(BLOCK_SIZE, -1);
+    if (b.chan == NULL || cache == NULL) {
+        return 1;
+    }
+
+    const la_allocator_t *allocators[2] = { la_malloc_allocator(), nc_get_allocator(cache) };
+    const char *workloads[2] = { "malloc", "nodecache" };
+
+    bench_begin(&config);
+    for (int i = 0; i < 2; ++i) {
+        b.allocator = allocators[i];
+        bench_run(&config, "nc", "alloc_free", workloads[i], 0,
+                  CONSTANT_BATCH, run_alloc_free, NULL, &b);
+        bench_run(&config, "nc", "produce_consume", workloads[i], LIST_NODES,
+                  LISTS * LIST_NODES, run_produce_consume, NULL, &b);
+    }
+    bench_end(&config);
+
+    nc_destroy_cache(cache);
+    chan_destroy(b.chan);
+    return 0;
+}
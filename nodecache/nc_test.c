@@ -0,0 +1,254 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <assert.h>
+#include <pthread.h>
+#include "nodecache.h"
+#include "../singlylinkedlist/singlylinkedlist.h"
+#include "../doublylinkedlist/doublylinkedlist.h"
+
+#define BLOCKS (10 * NC_MAGAZINE_SIZE)
+#define CONCURRENT_THREADS 4
+#define CONCURRENT_SLOTS 256
+#define CONCURRENT_ROUNDS 100000
+
+void test_create() {
+    printf("Running test_create...\n");
+    nc_cache_t *cache = nc_create_cache(24, -1);
+    assert(cache != NULL);
+
+    // blocks are rounded up to the alignment of max_align_t
+    const la_allocator_t *allocator = nc_get_allocator(cache);
+    size_t footprint = allocator->footprint(allocator->ctx, NULL, 24);
+    assert(footprint >= 24 && footprint % _Alignof(max_align_t) == 0);
+    assert(allocator->alloc(allocator->ctx, 25) == NULL);
+
+    nc_stats_t stats;
+    nc_get_stats(cache, &stats);
+    assert(stats.chunks == 0);
+    nc_destroy_cache(cache);
+
+    assert(nc_create_cache(0, -1) == NULL);
+    printf("Passed.\n");
+}
+
+void test_alloc_and_free() {
+    printf("Running test_alloc_and_free...\n");
+    nc_cache_t *cache = nc_create_cache(32, -1);
+    static void *blocks[BLOCKS];
+
+    for (int i = 0; i < BLOCKS; ++i) {
+        blocks[i] = nc_alloc(cache);
+        assert(blocks[i] != NULL);
+        assert((uintptr_t) blocks[i] % _Alignof(max_align_t) == 0);
+        *(int *) blocks[i] = i;
+    }
+    // fresh blocks come in address order and never overlap
+    for (int i = 1; i < BLOCKS; ++i) {
+        assert((char *) blocks[i] - (char *) blocks[i - 1] == 32);
+        assert(*(int *) blocks[i] == i);
+    }
+
+    nc_stats_t stats;
+    nc_get_stats(cache, &stats);
+    assert(stats.chunks == 1);
+    assert(stats.refills == BLOCKS / NC_MAGAZINE_SIZE);
+
+    // freed blocks are reused before any new chunk
+    for (int i = 0; i < BLOCKS; ++i) {
+        nc_free(cache, blocks[i]);
+    }
+    for (int i = 0; i < BLOCKS; ++i) {
+        assert(nc_alloc(cache) != NULL);
+    }
+    nc_get_stats(cache, &stats);
+    assert(stats.chunks == 1);
+    assert(stats.refills == BLOCKS / NC_MAGAZINE_SIZE);
+    assert(stats.depot_puts > 0 && stats.depot_gets > 0);
+
+    // binding to a node falls back to first touch where it is unsupported
+    nc_cache_t *bound = nc_create_cache(32, 0);
+    assert(nc_alloc(bound) != NULL);
+    nc_get_stats(bound, &stats);
+    assert(stats.chunks == 1 && stats.bound_chunks <= 1);
+    nc_destroy_cache(bound);
+
+    nc_destroy_cache(cache);
+    printf("Passed.\n");
+}
+
+static nc_cache_t *shared_cache;
+static void *handoff[BLOCKS];
+
+static void *producer(void *arg) {
+    (void)arg;
+    for (int i = 0; i < BLOCKS; ++i) {
+        handoff[i] = nc_alloc(shared_cache);
+        assert(handoff[i] != NULL);
+    }
+    return NULL;
+}
+
+void test_cross_thread() {
+    printf("Running test_cross_thread...\n");
+    shared_cache = nc_create_cache(32, -1);
+    nc_stats_t stats;
+
+    // a producer allocates, this thread frees
+    pthread_t thread;
+    assert(pthread_create(&thread, NULL, producer, NULL) == 0);
+    pthread_join(thread, NULL);
+    for (int i = 0; i < BLOCKS; ++i) {
+        nc_free(shared_cache, handoff[i]);
+    }
+    nc_flush_thread(shared_cache);
+
+    // the next producer gets the blocks back a magazine at a time
+    assert(pthread_create(&thread, NULL, producer, NULL) == 0);
+    pthread_join(thread, NULL);
+    nc_get_stats(shared_cache, &stats);
+    assert(stats.chunks == 1);
+    assert(stats.depot_gets == BLOCKS / NC_MAGAZINE_SIZE);
+
+    nc_destroy_cache(shared_cache);
+    printf("Passed.\n");
+}
+
+// frees half a magazine of handoff starting at the offset in arg
+static void *half_freer(void *arg) {
+    int offset = (int) (intptr_t) arg;
+    for (int i = 0; i < NC_MAGAZINE_SIZE / 2; ++i) {
+        nc_free(shared_cache, handoff[offset + i]);
+    }
+    return NULL;
+}
+
+void test_partial_magazines() {
+    printf("Running test_partial_magazines...\n");
+    shared_cache = nc_create_cache(32, -1);
+    nc_stats_t before;
+    nc_stats_t after;
+
+    for (int i = 0; i < 2 * NC_MAGAZINE_SIZE; ++i) {
+        handoff[i] = nc_alloc(shared_cache);
+        assert(handoff[i] != NULL);
+    }
+
+    // every thread leaves a half full magazine behind when it exits
+    for (int i = 0; i < 4; ++i) {
+        pthread_t thread;
+        assert(pthread_create(&thread, NULL, half_freer, (void *) (intptr_t) (i * NC_MAGAZINE_SIZE / 2)) == 0);
+        pthread_join(thread, NULL);
+    }
+
+    // the halves were merged, so two full magazines serve every block
+    nc_get_stats(shared_cache, &before);
+    for (int i = 0; i < 2 * NC_MAGAZINE_SIZE; ++i) {
+        assert(nc_alloc(shared_cache) != NULL);
+    }
+    nc_get_stats(shared_cache, &after);
+    assert(after.depot_gets - before.depot_gets == 2);
+    assert(after.refills == before.refills);
+
+    nc_destroy_cache(shared_cache);
+    printf("Passed.\n");
+}
+
+void test_lists() {
+    printf("Running test_lists...\n");
+    nc_cache_t *cache = nc_create_cache(32, -1);
+    const la_allocator_t *allocator = nc_get_allocator(cache);
+    la_usage_t usage;
+
+    sll_t *list = sll_create_linked_list();
+    assert(sll_set_allocator(list, allocator) == 0);
+    void *data[100];
+    for (intptr_t i = 0; i < 100; ++i) {
+        data[i] = (void *) (i + 1);
+    }
+    assert(sll_append_nodes(list, data, 100, NULL) == 0);
+    assert(sll_delete_head_node(list) == (void *) 1);
+    sll_memory_usage(list, &usage);
+    assert(usage.nodes == 99);
+    assert(usage.total_bytes - usage.header_bytes - usage.allocator_bytes == usage.node_bytes);
+    sll_destroy_linked_list(list);
+
+    dll_t *dll = dll_create_linked_list();
+    assert(dll_set_allocator(allocator, dll) == 1);
+    la_usage_t empty;
+    dll_memory_usage(&empty, dll);
+    assert(dll_append_nodes(data, 100, NULL, dll) == 1);
+    assert(dll_delete_end_node(dll) == (void *) 100);
+    dll_memory_usage(&usage, dll);
+    assert(usage.nodes == 99);
+    // every node takes one 32 byte block of the cache
+    assert(usage.total_bytes - empty.total_bytes == 99 * 32);
+    dll_destroy_linked_list(dll);
+
+    nc_destroy_cache(cache);
+    printf("Passed.\n");
+}
+
+static _Atomic(uintptr_t) slots[CONCURRENT_SLOTS];
+
+// blocks hold their own address, a block handed out twice gets overwritten
+static void *swapper(void *arg) {
+    uint64_t state = (uintptr_t) arg * 0x9E3779B97F4A7C15ull + 1;
+    for (int i = 0; i < CONCURRENT_ROUNDS; ++i) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+
+        uintptr_t *block = (uintptr_t *) nc_alloc(shared_cache);
+        assert(block != NULL);
+        *block = (uintptr_t) block;
+
+        uintptr_t old = atomic_exchange(&slots[state % CONCURRENT_SLOTS], (uintptr_t) block);
+        if (old != 0) {
+            assert(*(uintptr_t *) old == old);
+            nc_free(shared_cache, (void *) old);
+        }
+    }
+    return NULL;
+}
+
+void test_concurrent() {
+    printf("Running test_concurrent...\n");
+    shared_cache = nc_create_cache(32, -1);
+
+    pthread_t threads[CONCURRENT_THREADS];
+    for (intptr_t i = 0; i < CONCURRENT_THREADS; ++i) {
+        assert(pthread_create(&threads[i], NULL, swapper, (void *) (i + 1)) == 0);
+    }
+    for (int i = 0; i < CONCURRENT_THREADS; ++i) {
+        pthread_join(threads[i], NULL);
+    }
+
+    for (int i = 0; i < CONCURRENT_SLOTS; ++i) {
+        uintptr_t block = atomic_load(&slots[i]);
+        if (block != 0) {
+            assert(*(uintptr_t *) block == block);
+            nc_free(shared_cache, (void *) block);
+        }
+    }
+
+    // at most slots plus magazines held per thread were ever live
+    nc_stats_t stats;
+    nc_get_stats(shared_cache, &stats);
+    assert(stats.chunks <= 2);
+
+    nc_destroy_cache(shared_cache);
+    printf("Passed.\n");
+}
+
+int main(void) {
+    test_create();
+    test_alloc_and_free();
+    test_cross_thread();
+    test_partial_magazines();
+    test_lists();
+    test_concurrent();
+    printf("All tests passed successfully.\n");
+    return 0;
+}
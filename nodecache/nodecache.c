@@ -0,0 +1,446 @@
+#define _DEFAULT_SOURCE
+#include "nodecache.h"
+#include <stdlib.h>
+#include <pthread.h>
+#ifdef __linux__
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#define NC_CHUNK_SIZE (256 * 1024)
+#define NC_MPOL_PREFERRED 1
+#define NC_MAX_NUMA_NODES 256
+
+typedef struct NcMagazine {
+    struct NcMagazine *next;
+    int count;
+    void *blocks[NC_MAGAZINE_SIZE];
+} nc_magazine_t;
+
+// header at the start of every chunk, blocks are carved after it
+typedef struct NcChunk {
+    struct NcChunk *next;
+} nc_chunk_t;
+
+// per thread state, loaded serves requests and previous is always full or
+// empty, so a thread alternating allocs and frees at a magazine boundary
+// doesn't go to the depot every time
+typedef struct NcLocal {
+    nc_cache_t *cache;
+    nc_magazine_t *loaded;
+    nc_magazine_t *previous;
+    struct NcLocal *prev;
+    struct NcLocal *next;
+} nc_local_t;
+
+typedef struct NcCache {
+    la_allocator_t allocator;
+    size_t block_size;
+    size_t stride; // block size rounded up to the block alignment
+    int numa_node;
+    pthread_key_t key;
+    // everything below is the depot, guarded by lock
+    pthread_mutex_t lock;
+    nc_magazine_t *full;
+    nc_magazine_t *empty;
+    nc_magazine_t *partial; // partly filled, only ever one
+    nc_chunk_t *chunks;
+    char *carve; // next unused block of the newest chunk
+    char *carve_end;
+    nc_local_t *locals;
+    nc_stats_t stats;
+} nc_cache_t;
+
+static nc_magazine_t *nc_create_magazine(void) {
+    nc_magazine_t *magazine = (nc_magazine_t *) malloc(sizeof(nc_magazine_t));
+    if (magazine == NULL) {
+        return NULL;
+    }
+
+    magazine->next = NULL;
+    magazine->count = 0;
+    return magazine;
+}
+
+static void nc_free_magazines(nc_magazine_t *magazine) {
+    while (magazine != NULL) {
+        nc_magazine_t *next = magazine->next;
+        free(magazine);
+        magazine = next;
+    }
+}
+
+// lock held, puts a magazine on the full or empty list of the depot, a
+// partly filled one is merged into the partial magazine so every magazine
+// on the full list is full
+static void nc_depot_put(nc_cache_t *cache, nc_magazine_t *magazine) {
+    if (magazine->count > 0 && magazine->count < NC_MAGAZINE_SIZE) {
+        nc_magazine_t *partial = cache->partial;
+        if (partial == NULL) {
+            cache->partial = magazine;
+            return;
+        }
+
+        while (magazine->count > 0 && partial->count < NC_MAGAZINE_SIZE) {
+            partial->blocks[partial->count++] = magazine->blocks[--magazine->count];
+        }
+        if (partial->count == NC_MAGAZINE_SIZE) {
+            cache->partial = NULL;
+            nc_depot_put(cache, partial);
+            if (magazine->count > 0) {
+                cache->partial = magazine;
+                return;
+            }
+        }
+    }
+
+    if (magazine->count > 0) {
+        magazine->next = cache->full;
+        cache->full = magazine;
+    } else {
+        magazine->next = cache->empty;
+        cache->empty = magazine;
+    }
+}
+
+// lock held, maps a new chunk and makes it the one blocks are carved from
+static int nc_add_chunk(nc_cache_t *cache) {
+#ifdef __linux__
+    void *memory = mmap(NULL, NC_CHUNK_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED) {
+        return 1;
+    }
+
+    // the pages are untouched, so the policy decides where they land
+    if (cache->numa_node >= 0 && cache->numa_node < NC_MAX_NUMA_NODES) {
+        unsigned long mask[NC_MAX_NUMA_NODES / (8 * sizeof(unsigned long))] = { 0 };
+        mask[cache->numa_node / (8 * sizeof(unsigned long))] |= 1ul << (cache->numa_node % (8 * sizeof(unsigned long)));
+        if (syscall(SYS_mbind, memory, (unsigned long) NC_CHUNK_SIZE, NC_MPOL_PREFERRED,
+                    mask, (unsigned long) NC_MAX_NUMA_NODES + 1, 0u) == 0) {
+            cache->stats.bound_chunks++;
+        }
+    }
+#else
+    void *memory = malloc(NC_CHUNK_SIZE);
+    if (memory == NULL) {
+        return 1;
+    }
+#endif
+
+    nc_chunk_t *chunk = (nc_chunk_t *) memory;
+    chunk->next = cache->chunks;
+    cache->chunks = chunk;
+
+    size_t header = (sizeof(nc_chunk_t) + cache->stride - 1) / cache->stride * cache->stride;
+    cache->carve = (char *) memory + header;
+    cache->carve_end = (char *) memory + NC_CHUNK_SIZE;
+    cache->stats.chunks++;
+    return 0;
+}
+
+static void nc_free_chunk(nc_chunk_t *chunk) {
+#ifdef __linux__
+    munmap(chunk, NC_CHUNK_SIZE);
+#else
+    free(chunk);
+#endif
+}
+
+// moves the magazines of a thread to the depot and forgets the thread
+static void nc_release_local(nc_local_t *local) {
+    nc_cache_t *cache = local->cache;
+
+    pthread_mutex_lock(&cache->lock);
+    nc_depot_put(cache, local->loaded);
+    nc_depot_put(cache, local->previous);
+    if (local->prev != NULL) {
+        local->prev->next = local->next;
+    } else {
+        cache->locals = local->next;
+    }
+    if (local->next != NULL) {
+        local->next->prev = local->prev;
+    }
+    pthread_mutex_unlock(&cache->lock);
+
+    free(local);
+}
+
+// runs when a thread that used the cache exits
+static void nc_local_destructor(void *arg) {
+    nc_release_local((nc_local_t *) arg);
+}
+
+static nc_local_t *nc_get_local(nc_cache_t *cache) {
+    nc_local_t *local = (nc_local_t *) pthread_getspecific(cache->key);
+    if (local != NULL) {
+        return local;
+    }
+
+    local = (nc_local_t *) malloc(sizeof(nc_local_t));
+    if (local == NULL) {
+        return NULL;
+    }
+    local->cache = cache;
+    local->loaded = nc_create_magazine();
+    local->previous = nc_create_magazine();
+    if (local->loaded == NULL || local->previous == NULL || pthread_setspecific(cache->key, local) != 0) {
+        free(local->loaded);
+        free(local->previous);
+        free(local);
+        return NULL;
+    }
+
+    pthread_mutex_lock(&cache->lock);
+    local->prev = NULL;
+    local->next = cache->locals;
+    if (cache->locals != NULL) {
+        cache->locals->prev = local;
+    }
+    cache->locals = local;
+    pthread_mutex_unlock(&cache->lock);
+
+    return local;
+}
+
+// loaded is empty, makes it non-empty, returns 1 when out of memory
+static int nc_reload(nc_cache_t *cache, nc_local_t *local) {
+    if (local->previous->count > 0) {
+        nc_magazine_t *tmp = local->loaded;
+        local->loaded = local->previous;
+        local->previous = tmp;
+        return 0;
+    }
+
+    pthread_mutex_lock(&cache->lock);
+    if (cache->full != NULL || cache->partial != NULL) {
+        // trade the empty previous magazine for a full one, or the partial
+        // one once no full one is left
+        nc_magazine_t *magazine = cache->full;
+        if (magazine != NULL) {
+            cache->full = magazine->next;
+        } else {
+            magazine = cache->partial;
+            cache->partial = NULL;
+        }
+        nc_depot_put(cache, local->previous);
+        local->previous = local->loaded;
+        local->loaded = magazine;
+        cache->stats.depot_gets++;
+    } else {
+        // carve fresh blocks, reversed so they are handed out in address order
+        nc_magazine_t *magazine = local->loaded;
+        while (magazine->count < NC_MAGAZINE_SIZE) {
+            if ((cache->carve == NULL || (size_t) (cache->carve_end - cache->carve) < cache->stride)
+                && nc_add_chunk(cache) != 0) {
+                break;
+            }
+            magazine->blocks[magazine->count++] = cache->carve;
+            cache->carve += cache->stride;
+        }
+        for (int i = 0, j = magazine->count - 1; i < j; ++i, --j) {
+            void *tmp = magazine->blocks[i];
+            magazine->blocks[i] = magazine->blocks[j];
+            magazine->blocks[j] = tmp;
+        }
+        cache->stats.refills++;
+    }
+    pthread_mutex_unlock(&cache->lock);
+
+    return local->loaded->count > 0 ? 0 : 1;
+}
+
+// loaded is full, makes it non-full, returns 1 when out of memory
+static int nc_unload(nc_cache_t *cache, nc_local_t *local) {
+    if (local->previous->count == 0) {
+        nc_magazine_t *tmp = local->loaded;
+        local->loaded = local->previous;
+        local->previous = tmp;
+        return 0;
+    }
+
+    // trade the full previous magazine for an empty one
+    pthread_mutex_lock(&cache->lock);
+    nc_magazine_t *magazine = cache->empty;
+    if (magazine != NULL) {
+        cache->empty = magazine->next;
+    } else {
+        pthread_mutex_unlock(&cache->lock);
+        magazine = nc_create_magazine();
+        if (magazine == NULL) {
+            return 1;
+        }
+        pthread_mutex_lock(&cache->lock);
+    }
+    nc_depot_put(cache, local->previous);
+    cache->stats.depot_puts++;
+    pthread_mutex_unlock(&cache->lock);
+
+    local->previous = local->loaded;
+    local->loaded = magazine;
+    return 0;
+}
+
+static void *nc_la_alloc(void *ctx, size_t size) {
+    nc_cache_t *cache = ctx;
+    if (size > cache->block_size) {
+        return NULL;
+    }
+    return nc_alloc(cache);
+}
+
+static void nc_la_free(void *ctx, void *ptr, size_t size) {
+    (void)size;
+    nc_free((nc_cache_t *) ctx, ptr);
+}
+
+static size_t nc_la_footprint(void *ctx, void *ptr, size_t size) {
+    (void)ptr;
+    (void)size;
+    return ((nc_cache_t *) ctx)->stride;
+}
+
+static void *nc_la_alloc_many(void *ctx, size_t size, size_t count, size_t *allocated) {
+    nc_cache_t *cache = ctx;
+    nc_local_t *local = nc_get_local(cache);
+    *allocated = 0;
+    if (size > cache->block_size || local == NULL) {
+        return NULL;
+    }
+
+    // look the thread up once for the whole batch, blocks are at least a
+    // stride apart so their first word can link the chain
+    void *first = NULL;
+    void **link = &first;
+    size_t got = 0;
+    while (got < count) {
+        if (local->loaded->count == 0 && nc_reload(cache, local) != 0) {
+            break;
+        }
+        void *block = local->loaded->blocks[--local->loaded->count];
+        *link = block;
+        link = (void **) block;
+        got++;
+    }
+    *link = NULL;
+
+    *allocated = got;
+    return first;
+}
+
+nc_cache_t *nc_create_cache(size_t block_size, int numa_node) {
+    if (block_size == 0) {
+        return NULL;
+    }
+
+    nc_cache_t *cache = (nc_cache_t *) malloc(sizeof(nc_cache_t));
+    if (cache == NULL) {
+        return NULL;
+    }
+
+    if (pthread_key_create(&cache->key, nc_local_destructor) != 0) {
+        free(cache);
+        return NULL;
+    }
+
+    size_t align = _Alignof(max_align_t);
+    cache->allocator = (la_allocator_t) {
+        .alloc      = nc_la_alloc,
+        .free       = nc_la_free,
+        .footprint  = nc_la_footprint,
+        .ctx        = cache,
+        .alloc_many = nc_la_alloc_many,
+    };
+    cache->block_size = block_size;
+    cache->stride = (block_size + align - 1) / align * align;
+    cache->numa_node = numa_node;
+    pthread_mutex_init(&cache->lock, NULL);
+    cache->full = NULL;
+    cache->empty = NULL;
+    cache->partial = NULL;
+    cache->chunks = NULL;
+    cache->carve = NULL;
+    cache->carve_end = NULL;
+    cache->locals = NULL;
+    cache->stats = (nc_stats_t) { 0 };
+    return cache;
+}
+
+void nc_destroy_cache(nc_cache_t *cache) {
+    if (cache == NULL) {
+        return;
+    }
+
+    // threads that are still around never run the destructor for this key
+    pthread_key_delete(cache->key);
+    while (cache->locals != NULL) {
+        nc_local_t *local = cache->locals;
+        cache->locals = local->next;
+        free(local->loaded);
+        free(local->previous);
+        free(local);
+    }
+
+    nc_free_magazines(cache->full);
+    nc_free_magazines(cache->empty);
+    free(cache->partial);
+    while (cache->chunks != NULL) {
+        nc_chunk_t *chunk = cache->chunks;
+        cache->chunks = chunk->next;
+        nc_free_chunk(chunk);
+    }
+
+    pthread_mutex_destroy(&cache->lock);
+    free(cache);
+}
+
+const la_allocator_t *nc_get_allocator(nc_cache_t *cache) {
+    return &cache->allocator;
+}
+
+void *nc_alloc(nc_cache_t *cache) {
+    nc_local_t *local = nc_get_local(cache);
+    if (local == NULL) {
+        return NULL;
+    }
+
+    if (local->loaded->count == 0 && nc_reload(cache, local) != 0) {
+        return NULL;
+    }
+    return local->loaded->blocks[--local->loaded->count];
+}
+
+void nc_free(nc_cache_t *cache, void *ptr) {
+    if (ptr == NULL) {
+        return;
+    }
+
+    // without thread state or a spare magazine the block stays unused until
+    // the cache is destroyed, which only happens when malloc fails
+    nc_local_t *local = nc_get_local(cache);
+    if (local == NULL) {
+        return;
+    }
+
+    if (local->loaded->count == NC_MAGAZINE_SIZE && nc_unload(cache, local) != 0) {
+        return;
+    }
+    local->loaded->blocks[local->loaded->count++] = ptr;
+}
+
+void nc_flush_thread(nc_cache_t *cache) {
+    nc_local_t *local = (nc_local_t *) pthread_getspecific(cache->key);
+    if (local == NULL) {
+        return;
+    }
+
+    pthread_setspecific(cache->key, NULL);
+    nc_release_local(local);
+}
+
+void nc_get_stats(nc_cache_t *cache, nc_stats_t *stats) {
+    pthread_mutex_lock(&cache->lock);
+    *stats = cache->stats;
+    pthread_mutex_unlock(&cache->lock);
+}
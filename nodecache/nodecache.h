@@ -0,0 +1,105 @@
+/**
+ * @file nodecache.h
+ * @brief A thread-caching node allocator for the list modules.
+ * @note Each thread keeps two magazines of free blocks and serves allocations
+ * and frees from them without locking. Full and empty magazines are traded
+ * with a shared depot under a lock, so blocks freed by a consumer thread move
+ * back to the producer a magazine at a time instead of one by one. Blocks are
+ * carved from large chunks which can be bound to a NUMA node with `mbind` on
+ * Linux. Without a node, chunk pages are placed by first touch, i.e. on the
+ * node of the thread that first writes to the node allocated from them.
+ * The cache hands out blocks of one fixed size and plugs into the lists as
+ * an la_allocator_t.
+ */
+#ifndef NODECACHE_H
+#define NODECACHE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "../listalloc/listalloc.h"
+
+/**
+ * @brief The number of blocks in a magazine.
+ * @ingroup NodeCache
+ */
+#define NC_MAGAZINE_SIZE 64
+
+/**
+ * @brief A node cache structure.
+ * @ingroup NodeCache
+ */
+typedef struct NcCache nc_cache_t;
+
+/**
+ * @brief Counters of the shared work done by a cache.
+ * @ingroup NodeCache
+ */
+typedef struct NcStats {
+    uint64_t chunks; /**< The number of backing chunks allocated. */
+    uint64_t bound_chunks; /**< The number of chunks bound to the NUMA node. */
+    uint64_t depot_gets; /**< The number of full magazines taken from the depot. */
+    uint64_t depot_puts; /**< The number of full magazines given to the depot. */
+    uint64_t refills; /**< The number of magazines filled from a chunk. */
+} nc_stats_t;
+
+/**
+ * @brief Creates a new node cache.
+ * @param block_size The size of each block, 32 covers the nodes of both list modules.
+ * @param numa_node The NUMA node to bind chunks to, or -1 to place them by first touch.
+ * @return A pointer to the new cache, or NULL on failure.
+ * @note Binding falls back to first touch where `mbind` is unavailable.
+ * @ingroup NodeCache
+ */
+nc_cache_t *nc_create_cache(size_t block_size, int numa_node);
+
+/**
+ * @brief Destroys the cache and releases all of its chunks.
+ * @param cache A pointer to the cache.
+ * @note Every block handed out by the cache is invalid afterwards. No other
+ * thread may use the cache during or after this call.
+ * @ingroup NodeCache
+ */
+void nc_destroy_cache(nc_cache_t *cache);
+
+/**
+ * @brief Gets the allocator for passing the cache to the lists.
+ * @param cache A pointer to the cache.
+ * @return A pointer to the allocator, valid until the cache is destroyed.
+ * @ingroup NodeCache
+ */
+const la_allocator_t *nc_get_allocator(nc_cache_t *cache);
+
+/**
+ * @brief Allocates a block.
+ * @param cache A pointer to the cache.
+ * @return A pointer to the block, or NULL on failure.
+ * @ingroup NodeCache
+ */
+void *nc_alloc(nc_cache_t *cache);
+
+/**
+ * @brief Frees a block, from any thread.
+ * @param cache A pointer to the cache.
+ * @param ptr A pointer to the block.
+ * @ingroup NodeCache
+ */
+void nc_free(nc_cache_t *cache, void *ptr);
+
+/**
+ * @brief Returns the magazines of the calling thread to the depot.
+ * @param cache A pointer to the cache.
+ * @note Threads flush automatically when they exit. Flushing by hand lets
+ * other threads reuse the blocks of a thread that stops using the cache.
+ * @ingroup NodeCache
+ */
+void nc_flush_thread(nc_cache_t *cache);
+
+/**
+ * @brief Gets the counters of the cache.
+ * @param cache A pointer to the cache.
+ * @param stats A pointer receiving the counters.
+ * @ingroup NodeCache
+ */
+void nc_get_stats(nc_cache_t *cache, nc_stats_t *stats);
+
+#endif // NODECACHE_H
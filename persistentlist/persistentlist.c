@@ -0,0 +1,74 @@
+#include "persistentlist.h"
+#include <stdatomic.h>
+#include <stdlib.h>
+
+// node, immutable once published
+typedef struct PslNode {
+    atomic_int refcount;
+    int length; // length of the list starting at this node
+    void *data;
+    struct PslNode *next;
+} psl_t;
+
+psl_t *psl_push_front(psl_t *list, void *data) {
+    psl_t *new_node = (psl_t *) malloc(sizeof(psl_t));
+    if (new_node == NULL) {
+        return NULL;
+    }
+
+    // the new node holds a reference to the shared tail
+    atomic_init(&new_node->refcount, 1);
+    new_node->length = list != NULL ? list->length + 1 : 1;
+    new_node->data   = data;
+    new_node->next   = psl_retain(list);
+
+    return new_node;
+}
+
+psl_t *psl_pop_front(psl_t *list, void **data) {
+    // empty check
+    if (list == NULL) {
+        if (data != NULL) {
+            *data = NULL;
+        }
+        return NULL;
+    }
+
+    if (data != NULL) {
+        *data = list->data;
+    }
+    return psl_retain(list->next);
+}
+
+psl_t *psl_retain(psl_t *list) {
+    if (list != NULL) {
+        atomic_fetch_add_explicit(&list->refcount, 1, memory_order_relaxed);
+    }
+    return list;
+}
+
+void psl_release(psl_t *list) {
+    // free nodes front to back until one is still shared
+    while (list != NULL) {
+        // acq_rel so the last owner sees every other owner's reads done
+        if (atomic_fetch_sub_explicit(&list->refcount, 1, memory_order_acq_rel) != 1) {
+            return;
+        }
+
+        psl_t *tmp = list;
+        list = list->next;
+        free(tmp);
+    }
+}
+
+void *psl_get_front(const psl_t *list) {
+    return list != NULL ? list->data : NULL;
+}
+
+psl_t *psl_get_rest(const psl_t *list) {
+    return list != NULL ? list->next : NULL;
+}
+
+int psl_get_length(const psl_t *list) {
+    return list != NULL ? list->length : 0;
+}
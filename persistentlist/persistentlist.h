@@ -0,0 +1,82 @@
+/**
+ * @file persistentlist.h
+ * @brief A library for persistent (immutable) singly linked lists of generic data.
+ * @note Every operation leaves its input untouched and returns a new version
+ * of the list that shares its tail with the input. Nodes are reference
+ * counted, so taking a snapshot is O(1) and versions can be handed to other
+ * threads and released there without locks. The empty list is NULL.
+ * Every list returned by this library is a reference owned by the caller
+ * and must be released with psl_release().
+ * This library stores data using `void*` pointers. The user is responsible
+ * for managing the memory of the data stored in the list.
+ */
+#ifndef PERSISTENTLIST_H
+#define PERSISTENTLIST_H
+
+/**
+ * @brief A version of a persistent singly linked list.
+ * @ingroup PersistentList
+ */
+typedef struct PslNode psl_t;
+
+/**
+ * @brief Creates a new version with data in front of the list.
+ * @param list The list to extend, may be NULL for the empty list.
+ * @param data The data for the new node.
+ * @return The new version, or NULL on failure.
+ * @ingroup PersistentList
+ */
+psl_t *psl_push_front(psl_t *list, void *data);
+
+/**
+ * @brief Creates a new version without the first node of the list.
+ * @param list The list to shorten.
+ * @param data A pointer receiving the data of the first node, or NULL.
+ * @return The new version, which is NULL for an empty result or an empty input.
+ * @ingroup PersistentList
+ */
+psl_t *psl_pop_front(psl_t *list, void **data);
+
+/**
+ * @brief Takes a snapshot of the list in O(1).
+ * @param list The list, may be NULL.
+ * @return The same list with one more reference.
+ * @ingroup PersistentList
+ */
+psl_t *psl_retain(psl_t *list);
+
+/**
+ * @brief Releases a reference to the list.
+ * @param list The list, may be NULL.
+ * @note Frees every node that is no longer part of any version, the data
+ * stored in them is not freed. May be called from any thread.
+ * @ingroup PersistentList
+ */
+void psl_release(psl_t *list);
+
+/**
+ * @brief Gets the data of the first node.
+ * @param list The list.
+ * @return The data of the first node, or NULL for the empty list.
+ * @ingroup PersistentList
+ */
+void *psl_get_front(const psl_t *list);
+
+/**
+ * @brief Gets the list without its first node, without taking a reference.
+ * @param list The list.
+ * @return The rest of the list, only valid while list is held.
+ * @note Use this to walk a list, psl_pop_front() to keep the rest.
+ * @ingroup PersistentList
+ */
+psl_t *psl_get_rest(const psl_t *list);
+
+/**
+ * @brief Gets the size of the list in O(1).
+ * @param list The list.
+ * @return The number of nodes in the list.
+ * @ingroup PersistentList
+ */
+int psl_get_length(const psl_t *list);
+
+#endif // PERSISTENTLIST_H
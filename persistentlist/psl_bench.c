@@ -0,0 +1,107 @@
+/*
+ * Benchmarks for the persistent list against snapshotting a singly linked
+ * list by copying it, across list sizes.
+ *
+ * usage: psl_bench [--format=csv|json] [--min-size=N] [--max-size=N]
+ *                  [--warmup=N] [--repetitions=N] [--filter=TEXT]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "persistentlist.h"
+#include "../singlylinkedlist/singlylinkedlist.h"
+#include "../bench/bench.h"
+
+#define CONSTANT_BATCH 1000L
+
+typedef struct {
+    psl_t *list;
+    void **data;
+    long size;
+    sll_t *copy;
+} psl_bench_t;
+
+static void *value(long i) {
+    return (void *)(intptr_t)(i + 1);
+}
+
+// each new version is dropped right away, freeing only its own node
+static void run_push_front(void *ctx, long ops) {
+    psl_bench_t *b = ctx;
+    for (long i = 0; i < ops; ++i) {
+        psl_release(psl_push_front(b->list, value(i)));
+    }
+}
+
+static void run_pop_front(void *ctx, long ops) {
+    psl_bench_t *b = ctx;
+    for (long i = 0; i < ops; ++i) {
+        psl_release(psl_pop_front(b->list, NULL));
+    }
+}
+
+static void run_snapshot(void *ctx, long ops) {
+    psl_bench_t *b = ctx;
+    for (long i = 0; i < ops; ++i) {
+        psl_release(psl_retain(b->list));
+    }
+}
+
+// the copy a consistent sll snapshot needs, one op is a whole copy
+static void run_sll_copy(void *ctx, long ops) {
+    psl_bench_t *b = ctx;
+    (void)ops;
+    b->copy = sll_create_linked_list();
+    sll_append_nodes(b->copy, b->data, (int) b->size, NULL);
+}
+
+static void restore_sll_copy(void *ctx, long ops) {
+    psl_bench_t *b = ctx;
+    (void)ops;
+    sll_destroy_linked_list(b->copy);
+    b->copy = NULL;
+}
+
+int main(int argc, char **argv) {
+    bench_config_t config;
+    if (bench_parse_args(&config, argc, argv) != 0) {
+        return 1;
+    }
+
+    psl_bench_t b = { 0 };
+    bench_begin(&config);
+
+    for (long size = config.min_size; size <= config.max_size; size *= 10) {
+        b.size = size;
+        b.data = (void **) malloc(size * sizeof(void *));
+        if (b.data == NULL) {
+            return 1;
+        }
+
+        b.list = NULL;
+        for (long i = 0; i < size; ++i) {
+            b.data[i] = value(i);
+            psl_t *next = psl_push_front(b.list, value(i));
+            if (next == NULL) {
+                return 1;
+            }
+            psl_release(b.list);
+            b.list = next;
+        }
+
+        bench_run(&config, "psl", "psl_push_front", "head", size, CONSTANT_BATCH,
+                  run_push_front, NULL, &b);
+        bench_run(&config, "psl", "psl_pop_front", "head", size, CONSTANT_BATCH,
+                  run_pop_front, NULL, &b);
+        bench_run(&config, "psl", "psl_retain", "snapshot", size, CONSTANT_BATCH,
+                  run_snapshot, NULL, &b);
+        bench_run(&config, "psl", "sll_copy", "snapshot", size, 1,
+                  run_sll_copy, restore_sll_copy, &b);
+
+        psl_release(b.list);
+        free(b.data);
+    }
+
+    bench_end(&config);
+    return 0;
+}
@@ -0,0 +1,159 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <assert.h>
+#include <pthread.h>
+#include "persistentlist.h"
+
+void test_push_and_pop_front() {
+    printf("Running test_push_and_pop_front...\n");
+    psl_t *empty = NULL;
+    assert(psl_get_length(empty) == 0);
+    assert(psl_get_front(empty) == NULL);
+
+    psl_t *one = psl_push_front(empty, (void *)10);
+    psl_t *two = psl_push_front(one, (void *)20);
+    assert(psl_get_length(one) == 1);
+    assert(psl_get_length(two) == 2);
+    assert(psl_get_front(two) == (void *)20);
+
+    // Popping leaves the input untouched
+    void *data = NULL;
+    psl_t *rest = psl_pop_front(two, &data);
+    assert(data == (void *)20);
+    assert(rest == one);
+    assert(psl_get_length(two) == 2);
+
+    // Pop from empty
+    assert(psl_pop_front(NULL, &data) == NULL);
+    assert(data == NULL);
+
+    psl_release(rest);
+    psl_release(two);
+    psl_release(one);
+    printf("Passed.\n");
+}
+
+void test_structural_sharing() {
+    printf("Running test_structural_sharing...\n");
+    psl_t *base = NULL;
+    for (intptr_t i = 1; i <= 3; ++i) {
+        psl_t *next = psl_push_front(base, (void *)i);
+        psl_release(base);
+        base = next;
+    }
+    // base = [3, 2, 1]
+
+    psl_t *left = psl_push_front(base, (void *)4);
+    psl_t *right = psl_push_front(base, (void *)5);
+    assert(psl_get_rest(left) == base);
+    assert(psl_get_rest(right) == base);
+
+    // Dropping the base keeps the shared tail alive for both versions
+    psl_release(base);
+    psl_release(left);
+
+    intptr_t expected[] = { 5, 3, 2, 1 };
+    int i = 0;
+    for (psl_t *node = right; node != NULL; node = psl_get_rest(node)) {
+        assert(psl_get_front(node) == (void *)expected[i++]);
+    }
+    assert(i == 4);
+
+    psl_release(right);
+    printf("Passed.\n");
+}
+
+void test_snapshot() {
+    printf("Running test_snapshot...\n");
+    psl_t *list = psl_push_front(NULL, (void *)1);
+    psl_t *snapshot = psl_retain(list);
+    assert(snapshot == list);
+
+    // The writer moves on, the snapshot still sees the old version
+    psl_t *next = psl_push_front(list, (void *)2);
+    psl_release(list);
+    list = psl_pop_front(next, NULL);
+    psl_release(next);
+    next = psl_pop_front(list, NULL);
+    psl_release(list);
+    list = next;
+
+    assert(psl_get_length(list) == 0);
+    assert(psl_get_length(snapshot) == 1);
+    assert(psl_get_front(snapshot) == (void *)1);
+
+    psl_release(snapshot);
+    psl_release(list);
+    printf("Passed.\n");
+}
+
+#define READERS 3
+#define WRITES 100000
+
+static _Atomic(psl_t *) published;
+static pthread_mutex_t publish_lock = PTHREAD_MUTEX_INITIALIZER;
+static atomic_int writer_done;
+
+// readers grab the current version and walk it while the writer moves on
+static void *reader(void *arg) {
+    (void)arg;
+    while (!atomic_load(&writer_done)) {
+        // the lock only guards taking the reference, the walk is lock free
+        pthread_mutex_lock(&publish_lock);
+        psl_t *snapshot = psl_retain(atomic_load(&published));
+        pthread_mutex_unlock(&publish_lock);
+
+        int length = 0;
+        intptr_t last = INTPTR_MAX;
+        for (psl_t *node = snapshot; node != NULL; node = psl_get_rest(node)) {
+            // values were pushed in increasing order
+            assert((intptr_t) psl_get_front(node) < last);
+            last = (intptr_t) psl_get_front(node);
+            length++;
+        }
+        assert(length == psl_get_length(snapshot));
+
+        psl_release(snapshot);
+    }
+    return NULL;
+}
+
+void test_concurrent_readers() {
+    printf("Running test_concurrent_readers...\n");
+    atomic_store(&published, NULL);
+    atomic_store(&writer_done, 0);
+
+    pthread_t readers[READERS];
+    for (int i = 0; i < READERS; ++i) {
+        assert(pthread_create(&readers[i], NULL, reader, NULL) == 0);
+    }
+
+    psl_t *list = NULL;
+    for (intptr_t i = 1; i <= WRITES; ++i) {
+        psl_t *next = (i % 4 == 0) ? psl_pop_front(list, NULL) : psl_push_front(list, (void *)i);
+        pthread_mutex_lock(&publish_lock);
+        atomic_store(&published, next);
+        pthread_mutex_unlock(&publish_lock);
+        psl_release(list);
+        list = next;
+    }
+    atomic_store(&writer_done, 1);
+
+    for (int i = 0; i < READERS; ++i) {
+        pthread_join(readers[i], NULL);
+    }
+
+    psl_release(list);
+    printf("Passed.\n");
+}
+
+int main(void) {
+    test_push_and_pop_front();
+    test_structural_sharing();
+    test_snapshot();
+    test_concurrent_readers();
+    printf("All tests passed successfully.\n");
+    return 0;
+}
@@ -1,6 +1,12 @@
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
 #include "singlylinkedlist.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include "../liststats/liststats_internal.h"
+#include "../listalloc/listalloc_internal.h"
 
 // node 
 typedef struct SllNode {
@@ -12,8 +18,30 @@ typedef struct SllNode {
 typedef struct Sll {
     int length;
     sll_node_t *head;
+    sll_node_t *tail;
+    const la_allocator_t *allocator;
+    la_pool_t pool; // the default allocator
+    la_size_fn payload_size;
+    size_t node_footprint; // allocator footprint of all nodes
+    size_t payload_bytes;
+#ifdef CLIBSTRUCT_STATS
+    sll_stats_t stats;
+    uint64_t walked; // nodes walked by the running operation
+#endif
 } sll_t;
 
+#ifdef CLIBSTRUCT_STATS
+// moves the nodes walked by the finished operation to its counters
+#define SLL_STATS_OP(sll, op, timer) do {                   \
+        (sll)->stats.op_count[op]++;                        \
+        (sll)->stats.nodes_traversed[op] += (sll)->walked;  \
+        (sll)->walked = 0;                                  \
+        LS_TIMER_RECORD(timer, (sll)->stats.latency[op]);   \
+    } while (0)
+#else
+#define SLL_STATS_OP(sll, op, timer) ((void)0)
+#endif
+
 sll_t *sll_create_linked_list() {
     // initiating a new linked list
     sll_t *sll = (sll_t *) malloc(sizeof(sll_t));
@@ -21,58 +49,126 @@ sll_t *sll_create_linked_list() {
         return NULL;
     }
 
-    sll->length = 0;
-    sll->head   = NULL;
+    sll->length         = 0;
+    sll->head           = NULL;
+    sll->tail           = NULL;
+    sll->allocator      = &sll->pool.allocator;
+    sll->payload_size   = NULL;
+    sll->node_footprint = 0;
+    sll->payload_bytes  = 0;
+    la_pool_init(&sll->pool, sizeof(sll_node_t));
+#ifdef CLIBSTRUCT_STATS
+    memset(&sll->stats, 0, sizeof(sll->stats));
+    sll->walked = 0;
+#endif
     return sll;
 }
 
-int sll_add_head_node(sll_t *sll, void *data) {
+// accounts for a freshly allocated node and stores its data
+static void sll_init_node(sll_t *sll, sll_node_t *node, void *data) {
+    const la_allocator_t *allocator = sll->allocator;
+    LS_COUNT(sll->stats.allocations);
+
+    sll->node_footprint += allocator->footprint(allocator->ctx, node, sizeof(sll_node_t));
+    if (sll->payload_size != NULL) {
+        sll->payload_bytes += sll->payload_size(data);
+    }
+
+    node->data = data;
+}
+
+static sll_node_t *sll_alloc_node(sll_t *sll, void *data) {
+    const la_allocator_t *allocator = sll->allocator;
+    sll_node_t *node = (sll_node_t *) allocator->alloc(allocator->ctx, sizeof(sll_node_t));
+    if (node == NULL) {
+        return NULL;
+    }
+
+    sll_init_node(sll, node, data);
+    return node;
+}
+
+// allocates count nodes in one request, chained through their first word
+static void *sll_alloc_nodes(sll_t *sll, int count) {
+    size_t allocated = 0;
+    if (count <= 0) {
+        return NULL;
+    }
+
+    return la_alloc_many(sll->allocator, sizeof(sll_node_t), (size_t) count, &allocated);
+}
+
+// returns nodes a batch did not use to the allocator
+static void sll_release_nodes(sll_t *sll, void *chain) {
+    const la_allocator_t *allocator = sll->allocator;
+    void *node;
+    while ((node = la_chain_pop(&chain)) != NULL) {
+        allocator->free(allocator->ctx, node, sizeof(sll_node_t));
+    }
+}
+
+static void *sll_free_node(sll_t *sll, sll_node_t *node) {
+    const la_allocator_t *allocator = sll->allocator;
+    void *data = node->data;
+
+    sll->node_footprint -= allocator->footprint(allocator->ctx, node, sizeof(sll_node_t));
+    if (sll->payload_size != NULL) {
+        sll->payload_bytes -= sll->payload_size(data);
+    }
+
+    allocator->free(allocator->ctx, node, sizeof(sll_node_t));
+    LS_COUNT(sll->stats.frees);
+    return data;
+}
+
+static int sll_add_head(sll_t *sll, void *data) {
     // creating a new node
-    sll_node_t *new_node = (sll_node_t *) malloc(sizeof(sll_node_t));
+    sll_node_t *new_node = sll_alloc_node(sll, data);
     if (new_node == NULL) {
         return 1;
     }
 
-    new_node->data = data;
     new_node->next = sll->head;
 
+    // first node
+    if (sll->length == 0) {
+        sll->tail = new_node;
+    }
+
     sll->head = new_node;
     (sll->length)++;
 
     return 0;
 }
 
-int sll_add_tail_node(sll_t *sll, void *data) {
+static int sll_add_tail(sll_t *sll, void *data) {
     // creating a new node
-    sll_node_t *new_node = (sll_node_t *) malloc(sizeof(sll_node_t));
+    sll_node_t *new_node = sll_alloc_node(sll, data);
 
     if (new_node == NULL) {
         return 1;
     }
 
-    new_node->data = data;
     new_node->next = NULL;
 
     // empty list 
     if (sll->length == 0) {
-        sll_add_head_node(sll, data);
+        sll->head = new_node;
+        sll->tail = new_node;
+        (sll->length)++;
         return 0;
     }
 
     // non-empty list
-    sll_node_t *current_node = sll->head;
-    while (current_node->next != NULL) {
-        current_node = current_node->next;
-    }
-
-    current_node->next = new_node;
+    sll->tail->next = new_node;
+    sll->tail = new_node;
     (sll->length)++;
 
     return 0;
 }
 
 
-int sll_insert_node(sll_t *sll, int pos, void *data) {
+static int sll_insert(sll_t *sll, int pos, void *data) {
     // lower bound check and upper bound check
     if (pos < 0 || pos > sll->length) {
         return 1;
@@ -85,12 +181,12 @@ int sll_insert_node(sll_t *sll, int pos, void *data) {
 
     // insert at begining and to an empty list
     if (pos == 0) { 
-        return sll_add_head_node(sll, data);
+        return sll_add_head(sll, data);
     }
 
     // insert at end of the list
     if (pos == sll->length) {
-        return sll_add_tail_node(sll, data);
+        return sll_add_tail(sll, data);
     }
 
     // inserting new node at pos
@@ -98,13 +194,13 @@ int sll_insert_node(sll_t *sll, int pos, void *data) {
     for (int i = 0; i < pos - 1; ++i) {
         current_node = current_node->next;
     }
+    LS_ADD(sll->walked, pos - 1);
 
-    sll_node_t *new_node = (sll_node_t *) malloc(sizeof(sll_node_t));
+    sll_node_t *new_node = sll_alloc_node(sll, data);
     if (new_node == NULL) {
         return 1;
     }
 
-    new_node->data = data;
     new_node->next = current_node->next;
     current_node->next = new_node;
 
@@ -113,7 +209,7 @@ int sll_insert_node(sll_t *sll, int pos, void *data) {
     return 0;
 }
 
-void *sll_delete_head_node(sll_t *sll) {
+static void *sll_delete_head(sll_t *sll) {
     // empty check
     if (sll->length == 0) {
         return NULL;
@@ -122,9 +218,11 @@ void *sll_delete_head_node(sll_t *sll) {
     //delete current head node
     sll_node_t *tmp = sll->head;
     sll->head = sll->head->next;
+    if (sll->head == NULL) {
+        sll->tail = NULL;
+    }
 
-    void *data = tmp->data;
-    free(tmp);
+    void *data = sll_free_node(sll, tmp);
     tmp = NULL;
 
     (sll->length)--;
@@ -132,7 +230,7 @@ void *sll_delete_head_node(sll_t *sll) {
     return data;
 }
 
-void *sll_delete_tail_node(sll_t *sll) {
+static void *sll_delete_tail(sll_t *sll) {
     // empty check
     if (sll->length == 0) {
         return NULL;
@@ -140,10 +238,9 @@ void *sll_delete_tail_node(sll_t *sll) {
 
     // single node 
     if (sll->head->next == NULL) {
-        void *data = sll->head->data;
-
-        free(sll->head);
+        void *data = sll_free_node(sll, sll->head);
         sll->head = NULL;
+        sll->tail = NULL;
 
         (sll->length)--;
 
@@ -155,11 +252,12 @@ void *sll_delete_tail_node(sll_t *sll) {
 
     while (!(current_node->next->next == NULL)) {
         current_node = current_node->next;
+        LS_COUNT(sll->walked);
     }
 
-    void *data = current_node->next->data;
-    free(current_node->next);
+    void *data = sll_free_node(sll, current_node->next);
     current_node->next = NULL;
+    sll->tail = current_node;
 
     (sll->length)--;
 
@@ -167,7 +265,7 @@ void *sll_delete_tail_node(sll_t *sll) {
 }
 
 
-void *sll_delete_node( sll_t *sll, int pos) {
+static void *sll_delete(sll_t *sll, int pos) {
     // empty check
     if (sll->length == 0) {
         return NULL;
@@ -180,12 +278,12 @@ void *sll_delete_node( sll_t *sll, int pos) {
 
     // delete current head node
     if (pos == 0) {
-        return sll_delete_head_node(sll);
+        return sll_delete_head(sll);
     }
 
     // delete current tail node
     if (pos == (sll->length) - 1) {
-        return sll_delete_tail_node(sll);
+        return sll_delete_tail(sll);
     }
 
     // delete node at pos
@@ -194,12 +292,12 @@ void *sll_delete_node( sll_t *sll, int pos) {
     for (int i = 0; i < pos - 1; ++i) {
         current_node = current_node->next;
     }
+    LS_ADD(sll->walked, pos - 1);
 
     sll_node_t *tmp = current_node->next;
     current_node->next = current_node->next->next;
 
-    void *data = tmp->data;
-    free(tmp);
+    void *data = sll_free_node(sll, tmp);
     tmp = NULL;
 
     (sll->length)--;
@@ -207,31 +305,344 @@ void *sll_delete_node( sll_t *sll, int pos) {
     return data;
 }
 
-int sll_reverse_linked_list(sll_t *sll) {
+static int sll_reverse(sll_t *sll) {
     // empty check
     if (sll->length == 0) {
         return 1;
     }
 
+    // relink in place, the loop only tests for the end of the list
     sll_node_t *prev_node = NULL;
     sll_node_t *current_node = sll->head;
-    sll_node_t *next_node = sll->head->next;
-
-    for (int i = 0; i < sll->length; ++i) {
-        if (next_node == NULL) {
-            current_node->next = prev_node;
-            sll->head = current_node;
-            break;
-        }
-
+    while (current_node != NULL) {
+        sll_node_t *next_node = current_node->next;
         current_node->next = prev_node;
         prev_node = current_node;
         current_node = next_node;
-        next_node = next_node->next;
     }
+    LS_ADD(sll->walked, sll->length);
+
+    sll->tail = sll->head;
+    sll->head = prev_node;
 
     return 0;
+}
+
+static int sll_rotate(sll_t *sll, int k) {
+    // lower bound and upper bound check, also fails on an empty list
+    if (k < 0 || k >= sll->length) {
+        return 1;
+    }
+
+    if (k == 0) {
+        return 0;
+    }
+
+    // the node before the new head becomes the tail
+    sll_node_t *new_tail = sll->head;
+    for (int i = 0; i < k - 1; ++i) {
+        new_tail = new_tail->next;
+    }
+    LS_ADD(sll->walked, k - 1);
+
+    sll->tail->next = sll->head;
+    sll->head = new_tail->next;
+    new_tail->next = NULL;
+    sll->tail = new_tail;
+
+    return 0;
+}
+
+static int sll_partition(sll_t *sll, sll_pred_fn pred, void *ctx) {
+    // one pass, each node is appended to the matching or the other chain
+    sll_node_t *rest_head = NULL;
+    sll_node_t *match_tail = NULL;
+    sll_node_t *rest_tail = NULL;
+    sll_node_t **match_link = &sll->head;
+    sll_node_t **rest_link = &rest_head;
+    int matched = 0;
+
+    for (sll_node_t *current_node = sll->head; current_node != NULL; current_node = current_node->next) {
+        if (pred(current_node->data, ctx)) {
+            *match_link = current_node;
+            match_link = &current_node->next;
+            match_tail = current_node;
+            matched++;
+        } else {
+            *rest_link = current_node;
+            rest_link = &current_node->next;
+            rest_tail = current_node;
+        }
+    }
+    LS_ADD(sll->walked, sll->length);
+
+    *match_link = rest_head;
+    *rest_link = NULL;
+    sll->tail = rest_tail != NULL ? rest_tail : match_tail;
+
+    return matched;
+}
+
+static int sll_dedup(sll_t *sll, sll_equal_fn equal, sll_release_fn release, void *ctx) {
+    // empty check
+    if (sll->length == 0) {
+        return 0;
+    }
 
+    // keeps the first node of every run of equal data
+    int removed = 0;
+    sll_node_t *current_node = sll->head;
+    while (current_node->next != NULL) {
+        sll_node_t *next_node = current_node->next;
+        bool same = equal != NULL ? equal(current_node->data, next_node->data, ctx)
+                                  : current_node->data == next_node->data;
+        if (!same) {
+            current_node = next_node;
+            continue;
+        }
+
+        current_node->next = next_node->next;
+        void *data = sll_free_node(sll, next_node);
+        if (release != NULL) {
+            release(data, ctx);
+        }
+        removed++;
+    }
+    LS_ADD(sll->walked, sll->length);
+
+    sll->tail = current_node;
+    sll->length -= removed;
+
+    return removed;
+}
+
+static int sll_insert_batch(sll_t *sll, const sll_insert_item_t *items, int count, int *status) {
+    // items behave like consecutive sll_insert_node calls, count the ones
+    // that will fit so all nodes can be allocated up front
+    int wanted = 0;
+    int length = sll->length;
+    int last_pos = 0;
+    for (int i = 0; i < count; ++i) {
+        if (items[i].pos >= last_pos && items[i].pos <= length) {
+            last_pos = items[i].pos;
+            length++;
+            wanted++;
+        }
+    }
+
+    void *chain = sll_alloc_nodes(sll, wanted);
+
+    // one walk, positions never decrease
+    int failed = 0;
+    int index = 0;
+    sll_node_t **link = &sll->head;
+    last_pos = 0;
+    for (int i = 0; i < count; ++i) {
+        int pos = items[i].pos;
+        if (pos < last_pos || pos > sll->length || chain == NULL) {
+            if (status != NULL) {
+                status[i] = 1;
+            }
+            failed = 1;
+            continue;
+        }
+
+        while (index < pos) {
+            link = &(*link)->next;
+            index++;
+        }
+
+        sll_node_t *new_node = la_chain_pop(&chain);
+        sll_init_node(sll, new_node, items[i].data);
+        new_node->next = *link;
+        *link = new_node;
+        if (new_node->next == NULL) {
+            sll->tail = new_node;
+        }
+        (sll->length)++;
+
+        last_pos = pos;
+        if (status != NULL) {
+            status[i] = 0;
+        }
+    }
+    LS_ADD(sll->walked, index);
+
+    sll_release_nodes(sll, chain);
+    return failed;
+}
+
+static int sll_delete_batch(sll_t *sll, const int *positions, int count, void **data, int *status) {
+    int failed = 0;
+    int deleted = 0;
+    int index = 0;
+    int last_pos = -1;
+    sll_node_t *prev_node = NULL;
+    sll_node_t **link = &sll->head;
+
+    for (int i = 0; i < count; ++i) {
+        // positions refer to the list before the batch and must increase
+        int pos = positions[i];
+        if (pos <= last_pos || pos >= sll->length + deleted) {
+            if (data != NULL) {
+                data[i] = NULL;
+            }
+            if (status != NULL) {
+                status[i] = 1;
+            }
+            failed = 1;
+            continue;
+        }
+
+        while (index < pos - deleted) {
+            prev_node = *link;
+            link = &(*link)->next;
+            index++;
+        }
+
+        sll_node_t *tmp = *link;
+        *link = tmp->next;
+        if (tmp->next == NULL) {
+            sll->tail = prev_node;
+        }
+        void *item = sll_free_node(sll, tmp);
+        (sll->length)--;
+        deleted++;
+
+        last_pos = pos;
+        if (data != NULL) {
+            data[i] = item;
+        }
+        if (status != NULL) {
+            status[i] = 0;
+        }
+    }
+    LS_ADD(sll->walked, index);
+
+    return failed;
+}
+
+static int sll_append_batch(sll_t *sll, void *const *data, int count, int *status) {
+    void *chain = sll_alloc_nodes(sll, count);
+
+    sll_node_t **link = sll->tail != NULL ? &sll->tail->next : &sll->head;
+
+    int failed = 0;
+    for (int i = 0; i < count; ++i) {
+        if (chain == NULL) {
+            if (status != NULL) {
+                status[i] = 1;
+            }
+            failed = 1;
+            continue;
+        }
+
+        sll_node_t *new_node = la_chain_pop(&chain);
+        sll_init_node(sll, new_node, data[i]);
+        new_node->next = NULL;
+        *link = new_node;
+        link = &new_node->next;
+        sll->tail = new_node;
+        (sll->length)++;
+
+        if (status != NULL) {
+            status[i] = 0;
+        }
+    }
+
+    sll_release_nodes(sll, chain);
+    return failed;
+}
+
+int sll_add_head_node(sll_t *sll, void *data) {
+    LS_TIMER_START(start);
+    int ret = sll_add_head(sll, data);
+    SLL_STATS_OP(sll, SLL_OP_ADD_HEAD, start);
+    return ret;
+}
+
+int sll_add_tail_node(sll_t *sll, void *data) {
+    LS_TIMER_START(start);
+    int ret = sll_add_tail(sll, data);
+    SLL_STATS_OP(sll, SLL_OP_ADD_TAIL, start);
+    return ret;
+}
+
+int sll_insert_node(sll_t *sll, int pos, void *data) {
+    LS_TIMER_START(start);
+    int ret = sll_insert(sll, pos, data);
+    SLL_STATS_OP(sll, SLL_OP_INSERT, start);
+    return ret;
+}
+
+void *sll_delete_head_node(sll_t *sll) {
+    LS_TIMER_START(start);
+    void *data = sll_delete_head(sll);
+    SLL_STATS_OP(sll, SLL_OP_DELETE_HEAD, start);
+    return data;
+}
+
+void *sll_delete_tail_node(sll_t *sll) {
+    LS_TIMER_START(start);
+    void *data = sll_delete_tail(sll);
+    SLL_STATS_OP(sll, SLL_OP_DELETE_TAIL, start);
+    return data;
+}
+
+void *sll_delete_node( sll_t *sll, int pos) {
+    LS_TIMER_START(start);
+    void *data = sll_delete(sll, pos);
+    SLL_STATS_OP(sll, SLL_OP_DELETE, start);
+    return data;
+}
+
+int sll_reverse_linked_list(sll_t *sll) {
+    LS_TIMER_START(start);
+    int ret = sll_reverse(sll);
+    SLL_STATS_OP(sll, SLL_OP_REVERSE, start);
+    return ret;
+}
+
+int sll_rotate_linked_list(sll_t *sll, int k) {
+    LS_TIMER_START(start);
+    int ret = sll_rotate(sll, k);
+    SLL_STATS_OP(sll, SLL_OP_ROTATE, start);
+    return ret;
+}
+
+int sll_partition_linked_list(sll_t *sll, sll_pred_fn pred, void *ctx) {
+    LS_TIMER_START(start);
+    int matched = sll_partition(sll, pred, ctx);
+    SLL_STATS_OP(sll, SLL_OP_PARTITION, start);
+    return matched;
+}
+
+int sll_dedup_linked_list(sll_t *sll, sll_equal_fn equal, sll_release_fn release, void *ctx) {
+    LS_TIMER_START(start);
+    int removed = sll_dedup(sll, equal, release, ctx);
+    SLL_STATS_OP(sll, SLL_OP_DEDUP, start);
+    return removed;
+}
+
+int sll_insert_nodes(sll_t *sll, const sll_insert_item_t *items, int count, int *status) {
+    LS_TIMER_START(start);
+    int ret = sll_insert_batch(sll, items, count, status);
+    SLL_STATS_OP(sll, SLL_OP_INSERT_BATCH, start);
+    return ret;
+}
+
+int sll_delete_nodes(sll_t *sll, const int *positions, int count, void **data, int *status) {
+    LS_TIMER_START(start);
+    int ret = sll_delete_batch(sll, positions, count, data, status);
+    SLL_STATS_OP(sll, SLL_OP_DELETE_BATCH, start);
+    return ret;
+}
+
+int sll_append_nodes(sll_t *sll, void *const *data, int count, int *status) {
+    LS_TIMER_START(start);
+    int ret = sll_append_batch(sll, data, count, status);
+    SLL_STATS_OP(sll, SLL_OP_APPEND_BATCH, start);
+    return ret;
 }
 
 int sll_get_length(sll_t *sll) {
@@ -268,3 +679,98 @@ void sll_print_linked_list(sll_t *sll) {
     }
 
 }
+
+int sll_get_stats(sll_t *sll, sll_stats_t *stats) {
+#ifdef CLIBSTRUCT_STATS
+    *stats = sll->stats;
+    return 0;
+#else
+    (void)sll;
+    (void)stats;
+    return 1;
+#endif
+}
+
+void sll_reset_stats(sll_t *sll) {
+#ifdef CLIBSTRUCT_STATS
+    memset(&sll->stats, 0, sizeof(sll->stats));
+    sll->walked = 0;
+#else
+    (void)sll;
+#endif
+}
+
+void sll_destroy_linked_list(sll_t *sll) {
+    if (sll == NULL) {
+        return;
+    }
+
+    // the data may already be freed, so the accounting is skipped and the
+    // payload callback never runs, the default pool frees its slabs at once
+    const la_allocator_t *allocator = sll->allocator;
+    if (allocator != &sll->pool.allocator) {
+        while (sll->head != NULL) {
+            sll_node_t *tmp = sll->head;
+            sll->head = sll->head->next;
+            allocator->free(allocator->ctx, tmp, sizeof(sll_node_t));
+        }
+    }
+
+    la_pool_release(&sll->pool);
+    free(sll);
+}
+
+int sll_set_allocator(sll_t *sll, const la_allocator_t *allocator) {
+    // nodes must be freed by the allocator they came from
+    if (sll->length != 0) {
+        return 1;
+    }
+
+    // the list is empty, so the slabs of the default allocator are unused
+    if (allocator == NULL) {
+        allocator = &sll->pool.allocator;
+    } else if (allocator != &sll->pool.allocator) {
+        la_pool_release(&sll->pool);
+    }
+    sll->allocator = allocator;
+    return 0;
+}
+
+void sll_set_payload_size(sll_t *sll, la_size_fn payload_size) {
+    sll->payload_size  = payload_size;
+    sll->payload_bytes = 0;
+
+    if (payload_size == NULL) {
+        return;
+    }
+
+    // account for the nodes already in the list
+    sll_node_t *current_node = sll->head;
+    while (current_node != NULL) {
+        sll->payload_bytes += payload_size(current_node->data);
+        current_node = current_node->next;
+    }
+}
+
+int sll_trim_linked_list(sll_t *sll) {
+    // other allocators manage their own memory
+    if (sll->allocator != &sll->pool.allocator) {
+        return 0;
+    }
+
+    return la_pool_trim(&sll->pool) ? 0 : 1;
+}
+
+void sll_memory_usage(sll_t *sll, la_usage_t *usage) {
+    const la_allocator_t *header_allocator = la_malloc_allocator();
+    size_t header_footprint = header_allocator->footprint(header_allocator->ctx, sll, sizeof(sll_t));
+    // slab space of the default allocator not taken by nodes
+    size_t idle_bytes = la_pool_idle_bytes(&sll->pool);
+
+    usage->nodes           = (size_t) sll->length;
+    usage->node_bytes      = usage->nodes * sizeof(sll_node_t);
+    usage->header_bytes    = sizeof(sll_t);
+    usage->allocator_bytes = (sll->node_footprint - usage->node_bytes) + (header_footprint - usage->header_bytes) + idle_bytes;
+    usage->payload_bytes   = sll->payload_bytes;
+    usage->total_bytes     = sll->node_footprint + header_footprint + idle_bytes + sll->payload_bytes;
+}
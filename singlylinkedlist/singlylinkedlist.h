@@ -10,6 +10,9 @@
 #define SINGLYLINKEDLIST_H
 
 #include <stdbool.h>
+#include <stdint.h>
+#include "../liststats/liststats.h"
+#include "../listalloc/listalloc.h"
 
 /**
  * @brief A node in a singly linked list.
@@ -23,6 +26,68 @@ typedef struct SllNode sll_node_t;
  */
 typedef struct Sll sll_t;
 
+/**
+ * @brief The instrumented operations of a singly linked list.
+ * @ingroup SinglyLinkedList
+ */
+typedef enum SllOp {
+    SLL_OP_ADD_HEAD, /**< sll_add_head_node() */
+    SLL_OP_ADD_TAIL, /**< sll_add_tail_node() */
+    SLL_OP_INSERT, /**< sll_insert_node() */
+    SLL_OP_DELETE_HEAD, /**< sll_delete_head_node() */
+    SLL_OP_DELETE_TAIL, /**< sll_delete_tail_node() */
+    SLL_OP_DELETE, /**< sll_delete_node() */
+    SLL_OP_REVERSE, /**< sll_reverse_linked_list() */
+    SLL_OP_INSERT_BATCH, /**< sll_insert_nodes() */
+    SLL_OP_DELETE_BATCH, /**< sll_delete_nodes() */
+    SLL_OP_APPEND_BATCH, /**< sll_append_nodes() */
+    SLL_OP_ROTATE, /**< sll_rotate_linked_list() */
+    SLL_OP_PARTITION, /**< sll_partition_linked_list() */
+    SLL_OP_DEDUP, /**< sll_dedup_linked_list() */
+    SLL_OP_COUNT /**< The number of instrumented operations. */
+} sll_op_t;
+
+/**
+ * @brief Instrumentation counters of a singly linked list.
+ * @note Only collected when the library is built with `CLIBSTRUCT_STATS`,
+ * latencies only with `CLIBSTRUCT_STATS_TIMING`.
+ * @ingroup SinglyLinkedList
+ */
+typedef struct SllStats {
+    uint64_t allocations; /**< The number of nodes allocated. */
+    uint64_t frees; /**< The number of nodes freed. */
+    uint64_t op_count[SLL_OP_COUNT]; /**< The number of calls per operation. */
+    uint64_t nodes_traversed[SLL_OP_COUNT]; /**< The number of nodes walked per operation. */
+    ls_histogram_t latency[SLL_OP_COUNT]; /**< The latency histogram per operation. */
+} sll_stats_t;
+
+/**
+ * @brief A position and data pair for sll_insert_nodes().
+ * @ingroup SinglyLinkedList
+ */
+typedef struct SllInsertItem {
+    int pos; /**< The position to insert the data at. */
+    void *data; /**< The data for the new node. */
+} sll_insert_item_t;
+
+/**
+ * @brief A predicate on the data of a node, for sll_partition_linked_list().
+ * @ingroup SinglyLinkedList
+ */
+typedef bool (*sll_pred_fn)(void *data, void *ctx);
+
+/**
+ * @brief Compares the data of two nodes, for sll_dedup_linked_list().
+ * @ingroup SinglyLinkedList
+ */
+typedef bool (*sll_equal_fn)(void *a, void *b, void *ctx);
+
+/**
+ * @brief Receives the data of a node removed by sll_dedup_linked_list().
+ * @ingroup SinglyLinkedList
+ */
+typedef void (*sll_release_fn)(void *data, void *ctx);
+
 /**
  * @brief Creates a new, empty linked list.
  * @return A pointer to the new linked list structure, or NULL on failure.
@@ -30,6 +95,15 @@ typedef struct Sll sll_t;
  */
 sll_t *sll_create_linked_list();
 
+/**
+ * @brief Frees every node of the linked list and the list itself.
+ * @param sll A pointer to the linked list.
+ * @note The data stored in the nodes is not freed, nor passed to the payload
+ * size callback, so it may be freed before the list is destroyed.
+ * @ingroup SinglyLinkedList
+ */
+void sll_destroy_linked_list(sll_t *sll);
+
 /**
  * @brief Adds a new node to the beginning of the linked list.
  * @param sll A pointer to the linked list.
@@ -59,6 +133,31 @@ int sll_add_tail_node(sll_t *sll, void *data);
  */
 int sll_insert_node(sll_t *sll, int pos, void *data);
 
+/**
+ * @brief Inserts several nodes in a single walk of the linked list.
+ * @param sll A pointer to the linked list.
+ * @param items The items to insert, sorted by position.
+ * @param count The number of items.
+ * @param status An array receiving 0 or 1 per item, or NULL.
+ * @return 0 if every item was inserted, 1 otherwise.
+ * @note The result equals calling sll_insert_node() for each item in order.
+ * An item fails if its position is out of range or below the previous
+ * inserted position. All nodes are requested from the allocator at once.
+ * @ingroup SinglyLinkedList
+ */
+int sll_insert_nodes(sll_t *sll, const sll_insert_item_t *items, int count, int *status);
+
+/**
+ * @brief Appends several nodes to the end of the linked list in a single walk.
+ * @param sll A pointer to the linked list.
+ * @param data The data for the new nodes, in order.
+ * @param count The number of nodes.
+ * @param status An array receiving 0 or 1 per node, or NULL.
+ * @return 0 if every node was appended, 1 otherwise.
+ * @ingroup SinglyLinkedList
+ */
+int sll_append_nodes(sll_t *sll, void *const *data, int count, int *status);
+
 /**
  * @brief Deletes the first node of the linked list.
  * @param sll A pointer to the linked list.
@@ -87,6 +186,19 @@ void *sll_delete_tail_node(sll_t *sll);
  */
 void *sll_delete_node( sll_t *sll, int pos);
 
+/**
+ * @brief Deletes several nodes in a single walk of the linked list.
+ * @param sll A pointer to the linked list.
+ * @param positions The 0-based positions in the list before the call, strictly increasing.
+ * @param count The number of positions.
+ * @param data An array receiving the data of each deleted node, NULL on failure, or NULL.
+ * @param status An array receiving 0 or 1 per position, or NULL.
+ * @return 0 if every node was deleted, 1 otherwise.
+ * @note The caller is responsible for freeing the memory of the returned data.
+ * @ingroup SinglyLinkedList
+ */
+int sll_delete_nodes(sll_t *sll, const int *positions, int count, void **data, int *status);
+
 /**
  * @brief Reverses the order of the linked list.
  * @param sll A pointer to the linked list.
@@ -95,6 +207,40 @@ void *sll_delete_node( sll_t *sll, int pos);
  */
 int sll_reverse_linked_list(sll_t *sll);
 
+/**
+ * @brief Rotates the linked list so the node at a position becomes the head.
+ * @param sll A pointer to the linked list.
+ * @param k The 0-based position of the new head, in [0, length).
+ * @return 0 on success, 1 on failure.
+ * @note Walks k nodes and relinks three, nodes are neither allocated nor freed.
+ * @ingroup SinglyLinkedList
+ */
+int sll_rotate_linked_list(sll_t *sll, int k);
+
+/**
+ * @brief Moves the nodes whose data satisfies a predicate to the front.
+ * @param sll A pointer to the linked list.
+ * @param pred The predicate.
+ * @param ctx A pointer passed to the predicate.
+ * @return The number of nodes that satisfied the predicate.
+ * @note Stable for both groups. Relinks the nodes in one walk without
+ * allocating.
+ * @ingroup SinglyLinkedList
+ */
+int sll_partition_linked_list(sll_t *sll, sll_pred_fn pred, void *ctx);
+
+/**
+ * @brief Deletes all but the first node of every run of equal data.
+ * @param sll A pointer to the linked list.
+ * @param equal The comparison, or NULL to compare the data pointers.
+ * @param release A callback receiving the data of each deleted node, or NULL.
+ * @param ctx A pointer passed to the callbacks.
+ * @return The number of nodes deleted.
+ * @note Removes every duplicate of a sorted list in one walk.
+ * @ingroup SinglyLinkedList
+ */
+int sll_dedup_linked_list(sll_t *sll, sll_equal_fn equal, sll_release_fn release, void *ctx);
+
 /**
  * @brief Gets the size of the linked list.
  * @param sll A pointer to the linked list.
@@ -125,4 +271,61 @@ void sll_print_node(sll_node_t *node);
  */
 void sll_print_linked_list(sll_t *sll);
 
+/**
+ * @brief Gets the instrumentation counters of the linked list.
+ * @param sll A pointer to the linked list.
+ * @param stats A pointer to the structure receiving the counters.
+ * @return 0 on success, 1 if the library was built without `CLIBSTRUCT_STATS`.
+ * @ingroup SinglyLinkedList
+ */
+int sll_get_stats(sll_t *sll, sll_stats_t *stats);
+
+/**
+ * @brief Resets the instrumentation counters of the linked list.
+ * @param sll A pointer to the linked list.
+ * @ingroup SinglyLinkedList
+ */
+void sll_reset_stats(sll_t *sll);
+
+/**
+ * @brief Sets the allocator used for the nodes of the linked list.
+ * @param sll A pointer to the linked list.
+ * @param allocator A pointer to the allocator, which must outlive the list, or NULL for the default.
+ * @return 0 on success, 1 if the list is not empty.
+ * @ingroup SinglyLinkedList
+ */
+int sll_set_allocator(sll_t *sll, const la_allocator_t *allocator);
+
+/**
+ * @brief Registers a callback reporting the payload size of the stored data.
+ * @param sll A pointer to the linked list.
+ * @param payload_size The callback, or NULL to stop tracking payload bytes.
+ * @note Registering walks the list once to account for the existing nodes.
+ * The data must not change size while it is stored in the list.
+ * @ingroup SinglyLinkedList
+ */
+void sll_set_payload_size(sll_t *sll, la_size_fn payload_size);
+
+/**
+ * @brief Returns the unused slabs of the default allocator to the system.
+ * @param sll A pointer to the linked list.
+ * @return 0 on success, 1 if the memory to index the slabs could not be allocated.
+ * @note The default allocator keeps freed nodes for reuse and gives its slabs
+ * back on its own only once the list is empty. This frees every slab without
+ * a node in use in O(f log s) for f free nodes and s slabs. Does nothing for
+ * an allocator set with sll_set_allocator().
+ * @ingroup SinglyLinkedList
+ */
+int sll_trim_linked_list(sll_t *sll);
+
+/**
+ * @brief Gets the memory used by the linked list in O(1).
+ * @param sll A pointer to the linked list.
+ * @param usage A pointer to the structure receiving the breakdown.
+ * @note Slab space the default allocator keeps for reuse counts as allocator
+ * bytes, see sll_trim_linked_list().
+ * @ingroup SinglyLinkedList
+ */
+void sll_memory_usage(sll_t *sll, la_usage_t *usage);
+
 #endif // SINGLYLINKEDLIST_H
\ No newline at end of file
@@ -0,0 +1,331 @@
+/*
+ * Benchmarks for every sll_* operation across list sizes and head, tail and
+ * random-position workloads. Printing functions are not measured.
+ *
+ * usage: sll_bench [--format=csv|json] [--min-size=N] [--max-size=N]
+ *                  [--warmup=N] [--repetitions=N] [--filter=TEXT]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "singlylinkedlist.h"
+#include "../bench/bench.h"
+
+// node visits per batch for operations that walk the list
+#define LINEAR_BUDGET (1L << 22)
+// operations per batch for operations that don't
+#define CONSTANT_BATCH 1000L
+
+typedef struct {
+    sll_t *list;
+    sll_t *created[CONSTANT_BATCH];
+    sll_t *fresh; // an empty list with a cold default allocator
+    sll_insert_item_t items[CONSTANT_BATCH];
+    int positions[CONSTANT_BATCH];
+    void *data[CONSTANT_BATCH];
+    volatile intptr_t sink;
+} sll_bench_t;
+
+static void *value(long i) {
+    return (void *)(intptr_t)(i + 1);
+}
+
+// restores, always O(1)
+static void restore_delete_head(void *ctx, long ops) {
+    sll_bench_t *b = ctx;
+    for (long i = 0; i < ops; ++i) {
+        sll_delete_head_node(b->list);
+    }
+}
+
+static void restore_add_head(void *ctx, long ops) {
+    sll_bench_t *b = ctx;
+    for (long i = 0; i < ops; ++i) {
+        sll_add_head_node(b->list, value(i));
+    }
+}
+
+static void run_create(void *ctx, long ops) {
+    sll_bench_t *b = ctx;
+    for (long i = 0; i < ops; ++i) {
+        b->created[i] = sll_create_linked_list();
+    }
+}
+
+static void restore_create(void *ctx, long ops) {
+    sll_bench_t *b = ctx;
+    for (long i = 0; i < ops; ++i) {
+        sll_destroy_linked_list(b->created[i]);
+    }
+}
+
+// fill an empty list node by node or in one batch, so every node comes
+// from the allocator instead of the nodes a restore handed back
+static void run_fill_single(void *ctx, long ops) {
+    sll_bench_t *b = ctx;
+    for (long i = 0; i < ops; ++i) {
+        sll_add_tail_node(b->fresh, value(i));
+    }
+}
+
+static void run_fill_batch(void *ctx, long ops) {
+    sll_bench_t *b = ctx;
+    sll_append_nodes(b->fresh, b->data, (int) ops, NULL);
+}
+
+static void restore_fill(void *ctx, long ops) {
+    sll_bench_t *b = ctx;
+    (void)ops;
+    sll_destroy_linked_list(b->fresh);
+    b->fresh = sll_create_linked_list();
+}
+
+static void run_add_head(void *ctx, long ops) {
+    sll_bench_t *b = ctx;
+    for (long i = 0; i < ops; ++i) {
+        sll_add_head_node(b->list, value(i));
+    }
+}
+
+static void run_add_tail(void *ctx, long ops) {
+    sll_bench_t *b = ctx;
+    for (long i = 0; i < ops; ++i) {
+        sll_add_tail_node(b->list, value(i));
+    }
+}
+
+static void run_insert_head(void *ctx, long ops) {
+    sll_bench_t *b = ctx;
+    for (long i = 0; i < ops; ++i) {
+        sll_insert_node(b->list, 0, value(i));
+    }
+}
+
+static void run_insert_tail(void *ctx, long ops) {
+    sll_bench_t *b = ctx;
+    for (long i = 0; i < ops; ++i) {
+        sll_insert_node(b->list, sll_get_length(b->list), value(i));
+    }
+}
+
+static void run_insert_random(void *ctx, long ops) {
+    sll_bench_t *b = ctx;
+    for (long i = 0; i < ops; ++i) {
+        sll_insert_node(b->list, (int) bench_random(sll_get_length(b->list) + 1), value(i));
+    }
+}
+
+static void run_delete_head(void *ctx, long ops) {
+    sll_bench_t *b = ctx;
+    for (long i = 0; i < ops; ++i) {
+        sll_delete_head_node(b->list);
+    }
+}
+
+static void run_delete_tail(void *ctx, long ops) {
+    sll_bench_t *b = ctx;
+    for (long i = 0; i < ops; ++i) {
+        sll_delete_tail_node(b->list);
+    }
+}
+
+static void run_delete_node_head(void *ctx, long ops) {
+    sll_bench_t *b = ctx;
+    for (long i = 0; i < ops; ++i) {
+        sll_delete_node(b->list, 0);
+    }
+}
+
+static void run_delete_node_tail(void *ctx, long ops) {
+    sll_bench_t *b = ctx;
+    for (long i = 0; i < ops; ++i) {
+        sll_delete_node(b->list, sll_get_length(b->list) - 1);
+    }
+}
+
+static void run_delete_node_random(void *ctx, long ops) {
+    sll_bench_t *b = ctx;
+    for (long i = 0; i < ops; ++i) {
+        sll_delete_node(b->list, (int) bench_random(sll_get_length(b->list)));
+    }
+}
+
+// one call per batch, positions are prepared by fill_positions
+static void run_insert_nodes(void *ctx, long ops) {
+    sll_bench_t *b = ctx;
+    sll_insert_nodes(b->list, b->items, (int) ops, NULL);
+}
+
+static void run_delete_nodes(void *ctx, long ops) {
+    sll_bench_t *b = ctx;
+    sll_delete_nodes(b->list, b->positions, (int) ops, NULL, NULL);
+}
+
+static void run_append_nodes(void *ctx, long ops) {
+    sll_bench_t *b = ctx;
+    sll_append_nodes(b->list, b->data, (int) ops, NULL);
+}
+
+static void run_reverse(void *ctx, long ops) {
+    sll_bench_t *b = ctx;
+    for (long i = 0; i < ops; ++i) {
+        sll_reverse_linked_list(b->list);
+    }
+}
+
+// rotations by half the list, through the relinking call and through the
+// delete and re-insert it replaces
+static void run_rotate(void *ctx, long ops) {
+    sll_bench_t *b = ctx;
+    for (long i = 0; i < ops; ++i) {
+        sll_rotate_linked_list(b->list, sll_get_length(b->list) / 2);
+    }
+}
+
+static void run_rotate_reinsert(void *ctx, long ops) {
+    sll_bench_t *b = ctx;
+    for (long i = 0; i < ops; ++i) {
+        for (int k = sll_get_length(b->list) / 2; k > 0; --k) {
+            sll_add_tail_node(b->list, sll_delete_head_node(b->list));
+        }
+    }
+}
+
+static bool is_even(void *data, void *ctx) {
+    (void)ctx;
+    return (intptr_t) data % 2 == 0;
+}
+
+static void run_partition(void *ctx, long ops) {
+    sll_bench_t *b = ctx;
+    for (long i = 0; i < ops; ++i) {
+        b->sink += sll_partition_linked_list(b->list, is_even, NULL);
+    }
+}
+
+// the data is distinct, so every node is compared and none deleted
+static void run_dedup(void *ctx, long ops) {
+    sll_bench_t *b = ctx;
+    for (long i = 0; i < ops; ++i) {
+        b->sink += sll_dedup_linked_list(b->list, NULL, NULL, NULL);
+    }
+}
+
+static void run_get_length(void *ctx, long ops) {
+    sll_bench_t *b = ctx;
+    for (long i = 0; i < ops; ++i) {
+        b->sink += sll_get_length(b->list);
+    }
+}
+
+static void run_get_head(void *ctx, long ops) {
+    sll_bench_t *b = ctx;
+    for (long i = 0; i < ops; ++i) {
+        b->sink += (intptr_t) sll_get_head(b->list);
+    }
+}
+
+typedef struct {
+    const char *operation;
+    const char *workload;
+    bench_fn run;
+    bench_fn restore;
+    int linear;
+} sll_case_t;
+
+static const sll_case_t cases[] = {
+    { "sll_add_head_node",       "head",   run_add_head,           restore_delete_head, 0 },
+    { "sll_add_tail_node",       "tail",   run_add_tail,           restore_delete_head, 0 },
+    { "sll_insert_node",         "head",   run_insert_head,        restore_delete_head, 0 },
+    { "sll_insert_node",         "tail",   run_insert_tail,        restore_delete_head, 0 },
+    { "sll_insert_node",         "random", run_insert_random,      restore_delete_head, 1 },
+    { "sll_delete_head_node",    "head",   run_delete_head,        restore_add_head,    0 },
+    { "sll_delete_tail_node",    "tail",   run_delete_tail,        restore_add_head,    1 },
+    { "sll_delete_node",         "head",   run_delete_node_head,   restore_add_head,    0 },
+    { "sll_delete_node",         "tail",   run_delete_node_tail,   restore_add_head,    1 },
+    { "sll_delete_node",         "random", run_delete_node_random, restore_add_head,    1 },
+    { "sll_insert_nodes",        "random", run_insert_nodes,       restore_delete_head, 0 },
+    { "sll_delete_nodes",        "random", run_delete_nodes,       restore_add_head,    0 },
+    { "sll_append_nodes",        "tail",   run_append_nodes,       restore_delete_head, 0 },
+    { "sll_reverse_linked_list", "all",    run_reverse,            NULL,                1 },
+    { "sll_rotate_linked_list",  "half",   run_rotate,             NULL,                1 },
+    { "sll_delete_head_node+sll_add_tail_node", "half", run_rotate_reinsert, NULL,      1 },
+    { "sll_partition_linked_list", "all",  run_partition,          NULL,                1 },
+    { "sll_dedup_linked_list",   "all",    run_dedup,              NULL,                1 },
+    { "sll_get_length",          "none",   run_get_length,         NULL,                0 },
+    { "sll_get_head",            "none",   run_get_head,           NULL,                0 },
+};
+
+// strictly increasing random positions, one per stride of the list
+static void fill_positions(sll_bench_t *b, long size, long ops) {
+    long stride = size / ops;
+    for (long i = 0; i < ops; ++i) {
+        int pos = (int) (i * stride + bench_random(stride));
+        b->positions[i] = pos;
+        b->items[i].pos = pos;
+        b->items[i].data = value(i);
+        b->data[i] = value(i);
+    }
+}
+
+// batches never shrink the list below half its size
+static long batch_size(long size, int linear) {
+    long ops = linear ? LINEAR_BUDGET / size : CONSTANT_BATCH;
+    if (ops > size / 2) {
+        ops = size / 2;
+    }
+    return ops > 0 ? ops : 1;
+}
+
+int main(int argc, char **argv) {
+    bench_config_t config;
+    if (bench_parse_args(&config, argc, argv) != 0) {
+        return 1;
+    }
+
+    sll_bench_t b = { 0 };
+    bench_begin(&config);
+
+    // independent of the list size
+    bench_run(&config, "sll", "sll_create_linked_list", "none", 0, CONSTANT_BATCH,
+              run_create, restore_create, &b);
+
+    // node allocation with the default allocator, one node per op
+    b.fresh = sll_create_linked_list();
+    if (b.fresh == NULL) {
+        return 1;
+    }
+    for (long i = 0; i < CONSTANT_BATCH; ++i) {
+        b.data[i] = value(i);
+    }
+    bench_run(&config, "sll", "sll_add_tail_node", "fresh", 0, CONSTANT_BATCH,
+              run_fill_single, restore_fill, &b);
+    bench_run(&config, "sll", "sll_append_nodes", "fresh", 0, CONSTANT_BATCH,
+              run_fill_batch, restore_fill, &b);
+    sll_destroy_linked_list(b.fresh);
+
+    for (long size = config.min_size; size <= config.max_size; size *= 10) {
+        b.list = sll_create_linked_list();
+        if (b.list == NULL) {
+            return 1;
+        }
+        for (long i = 0; i < size; ++i) {
+            if (sll_add_head_node(b.list, value(i)) != 0) {
+                return 1;
+            }
+        }
+
+        fill_positions(&b, size, batch_size(size, 0));
+
+        for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); ++i) {
+            const sll_case_t *c = &cases[i];
+            bench_run(&config, "sll", c->operation, c->workload, size,
+                      batch_size(size, c->linear), c->run, c->restore, &b);
+        }
+
+        sll_destroy_linked_list(b.list);
+    }
+
+    bench_end(&config);
+    return 0;
+}
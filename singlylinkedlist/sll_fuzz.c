@@ -0,0 +1,385 @@
+/*
+ * Differential fuzzing of the singly linked list against an array model.
+ *
+ * Replays a random sequence of every sll_* operation, including positions
+ * out of range and operations on the empty list, and checks the results,
+ * the length and the node count after each step. The nodes are opaque, so
+ * the contents are compared every CHECK_INTERVAL steps by draining the list
+ * and appending it back. Built with CLIBSTRUCT_STATS it also bounds the
+ * nodes each operation walks. Finally the constant time operations are
+ * timed on a small and a large list.
+ *
+ * usage: sll_fuzz [--seed=N] [--ops=N] [--max-size=N] [--large-size=N]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "singlylinkedlist.h"
+#include "../fuzz/fuzz.h"
+
+#define MAX_BATCH 8
+#define CHECK_INTERVAL 8
+
+typedef enum {
+    FUZZ_ADD_HEAD,
+    FUZZ_ADD_TAIL,
+    FUZZ_INSERT,
+    FUZZ_DELETE_HEAD,
+    FUZZ_DELETE_TAIL,
+    FUZZ_DELETE,
+    FUZZ_REVERSE,
+    FUZZ_INSERT_BATCH,
+    FUZZ_DELETE_BATCH,
+    FUZZ_APPEND_BATCH,
+    FUZZ_ROTATE,
+    FUZZ_PARTITION,
+    FUZZ_DEDUP,
+    FUZZ_OP_COUNT
+} fuzz_op_t;
+
+static sll_t *list = NULL;
+static fuzz_model_t model;
+static intptr_t next_value = 1;
+
+// distinct and never NULL, so a failed delete can't pass for a match
+static void *next_data(void) {
+    return (void *) next_value++;
+}
+
+// the data dedup hands to collect, next to the data the model removed
+typedef struct {
+    void **items;
+    void **expected;
+    int count;
+} released_t;
+
+static released_t released;
+
+static bool divisible(void *data, void *ctx) {
+    return (intptr_t) data % *(intptr_t *) ctx == 0;
+}
+
+// values in the same group of four are duplicates, so appends form runs
+static bool same_group(void *a, void *b, void *ctx) {
+    (void)ctx;
+    return (intptr_t) a / 4 == (intptr_t) b / 4;
+}
+
+static void collect(void *data, void *ctx) {
+    released_t *r = ctx;
+    FUZZ_CHECK(r->count < model.capacity);
+    r->items[r->count++] = data;
+}
+
+static void check_length(void) {
+    FUZZ_CHECK(sll_get_length(list) == model.length);
+
+    la_usage_t usage;
+    sll_memory_usage(list, &usage);
+    FUZZ_CHECK(usage.nodes == (size_t) model.length);
+}
+
+static void check_list(void) {
+    for (int i = 0; i < model.length; ++i) {
+        FUZZ_CHECK(sll_delete_head_node(list) == model.items[i]);
+    }
+    FUZZ_CHECK(sll_get_length(list) == 0);
+    FUZZ_CHECK(sll_append_nodes(list, model.items, model.length, NULL) == 0);
+    check_length();
+}
+
+#ifdef CLIBSTRUCT_STATS
+static uint64_t walked(sll_op_t op) {
+    sll_stats_t stats;
+    sll_get_stats(list, &stats);
+    return stats.nodes_traversed[op];
+}
+
+#define CHECK_WALK(op, before, bound) FUZZ_CHECK(walked(op) - (before) <= (uint64_t) (bound))
+#else
+static uint64_t walked(sll_op_t op) {
+    (void)op;
+    return 0;
+}
+
+#define CHECK_WALK(op, before, bound) ((void)(before), (void)(bound))
+#endif
+
+// a position in [-1, length + 1], so both bounds are exercised
+static int random_pos(int length) {
+    return (int) fuzz_random(length + 3) - 1;
+}
+
+// count positions in [0, bound), sorted, with an occasional pair out of order
+static void random_positions(int *positions, int count, int bound) {
+    for (int i = 0; i < count; ++i) {
+        int pos = (int) fuzz_random(bound);
+        int j = i;
+        while (j > 0 && positions[j - 1] > pos) {
+            positions[j] = positions[j - 1];
+            j--;
+        }
+        positions[j] = pos;
+    }
+
+    if (count > 1 && fuzz_random(4) == 0) {
+        int i = (int) fuzz_random(count - 1);
+        int tmp = positions[i];
+        positions[i] = positions[i + 1];
+        positions[i + 1] = tmp;
+    }
+}
+
+static void step(fuzz_op_t op, int max_size) {
+    int length = model.length;
+    int pos = random_pos(length);
+    int count = (int) fuzz_random(MAX_BATCH) + 1;
+    int positions[MAX_BATCH];
+    void *data[MAX_BATCH];
+    void *expected[MAX_BATCH];
+    int status[MAX_BATCH];
+    int expected_status[MAX_BATCH];
+
+    // keep the list below max_size
+    if (length >= max_size) {
+        if (op == FUZZ_ADD_HEAD || op == FUZZ_ADD_TAIL || op == FUZZ_INSERT) {
+            op = FUZZ_DELETE;
+        } else if (op == FUZZ_INSERT_BATCH || op == FUZZ_APPEND_BATCH) {
+            op = FUZZ_DELETE_BATCH;
+        }
+    }
+
+    switch (op) {
+    case FUZZ_ADD_HEAD: {
+        uint64_t before = walked(SLL_OP_ADD_HEAD);
+        void *value = next_data();
+        FUZZ_CHECK(sll_add_head_node(list, value) == 0);
+        fuzz_model_insert(&model, 0, value);
+        CHECK_WALK(SLL_OP_ADD_HEAD, before, 0);
+        break;
+    }
+    case FUZZ_ADD_TAIL: {
+        uint64_t before = walked(SLL_OP_ADD_TAIL);
+        void *value = next_data();
+        FUZZ_CHECK(sll_add_tail_node(list, value) == 0);
+        fuzz_model_insert(&model, length, value);
+        CHECK_WALK(SLL_OP_ADD_TAIL, before, 0);
+        break;
+    }
+    case FUZZ_INSERT: {
+        uint64_t before = walked(SLL_OP_INSERT);
+        void *value = next_data();
+        int expected_ret = fuzz_model_insert(&model, pos, value);
+        FUZZ_CHECK(sll_insert_node(list, pos, value) == expected_ret);
+        CHECK_WALK(SLL_OP_INSERT, before, pos <= length ? pos : 0);
+        break;
+    }
+    case FUZZ_DELETE_HEAD: {
+        uint64_t before = walked(SLL_OP_DELETE_HEAD);
+        FUZZ_CHECK(sll_delete_head_node(list) == fuzz_model_delete(&model, 0));
+        CHECK_WALK(SLL_OP_DELETE_HEAD, before, 0);
+        break;
+    }
+    case FUZZ_DELETE_TAIL: {
+        uint64_t before = walked(SLL_OP_DELETE_TAIL);
+        FUZZ_CHECK(sll_delete_tail_node(list) == fuzz_model_delete(&model, length - 1));
+        CHECK_WALK(SLL_OP_DELETE_TAIL, before, length);
+        break;
+    }
+    case FUZZ_DELETE: {
+        uint64_t before = walked(SLL_OP_DELETE);
+        FUZZ_CHECK(sll_delete_node(list, pos) == fuzz_model_delete(&model, pos));
+        CHECK_WALK(SLL_OP_DELETE, before, pos < length ? pos : 0);
+        break;
+    }
+    case FUZZ_REVERSE: {
+        uint64_t before = walked(SLL_OP_REVERSE);
+        FUZZ_CHECK(sll_reverse_linked_list(list) == (length == 0));
+        fuzz_model_reverse(&model);
+        CHECK_WALK(SLL_OP_REVERSE, before, length);
+        break;
+    }
+    case FUZZ_INSERT_BATCH: {
+        sll_insert_item_t items[MAX_BATCH];
+        random_positions(positions, count, length + 2);
+        for (int i = 0; i < count; ++i) {
+            data[i] = next_data();
+            items[i].pos = positions[i];
+            items[i].data = data[i];
+        }
+
+        uint64_t before = walked(SLL_OP_INSERT_BATCH);
+        fuzz_model_insert_batch(&model, positions, data, count, expected_status);
+        int expected_ret = 0;
+        for (int i = 0; i < count; ++i) {
+            expected_ret |= expected_status[i];
+        }
+        FUZZ_CHECK(sll_insert_nodes(list, items, count, status) == expected_ret);
+        for (int i = 0; i < count; ++i) {
+            FUZZ_CHECK(status[i] == expected_status[i]);
+        }
+        CHECK_WALK(SLL_OP_INSERT_BATCH, before, length + count);
+        break;
+    }
+    case FUZZ_DELETE_BATCH: {
+        random_positions(positions, count, length + 1);
+
+        uint64_t before = walked(SLL_OP_DELETE_BATCH);
+        fuzz_model_delete_batch(&model, positions, count, expected, expected_status);
+        int expected_ret = 0;
+        for (int i = 0; i < count; ++i) {
+            expected_ret |= expected_status[i];
+        }
+        FUZZ_CHECK(sll_delete_nodes(list, positions, count, data, status) == expected_ret);
+        for (int i = 0; i < count; ++i) {
+            FUZZ_CHECK(status[i] == expected_status[i]);
+            FUZZ_CHECK(data[i] == expected[i]);
+        }
+        CHECK_WALK(SLL_OP_DELETE_BATCH, before, length);
+        break;
+    }
+    case FUZZ_APPEND_BATCH: {
+        for (int i = 0; i < count; ++i) {
+            data[i] = next_data();
+            fuzz_model_insert(&model, length + i, data[i]);
+        }
+
+        uint64_t before = walked(SLL_OP_APPEND_BATCH);
+        FUZZ_CHECK(sll_append_nodes(list, data, count, status) == 0);
+        for (int i = 0; i < count; ++i) {
+            FUZZ_CHECK(status[i] == 0);
+        }
+        CHECK_WALK(SLL_OP_APPEND_BATCH, before, 0);
+        break;
+    }
+    case FUZZ_ROTATE: {
+        uint64_t before = walked(SLL_OP_ROTATE);
+        FUZZ_CHECK(sll_rotate_linked_list(list, pos) == fuzz_model_rotate(&model, pos));
+        CHECK_WALK(SLL_OP_ROTATE, before, pos > 0 && pos < length ? pos : 0);
+        break;
+    }
+    case FUZZ_PARTITION: {
+        intptr_t modulus = (intptr_t) fuzz_random(3) + 1;
+        uint64_t before = walked(SLL_OP_PARTITION);
+        FUZZ_CHECK(sll_partition_linked_list(list, divisible, &modulus) == fuzz_model_partition(&model, divisible, &modulus));
+        CHECK_WALK(SLL_OP_PARTITION, before, length);
+        break;
+    }
+    case FUZZ_DEDUP: {
+        // NULL compares the pointers, which are distinct
+        bool (*equal)(void *, void *, void *) = fuzz_random(4) == 0 ? NULL : same_group;
+        released.count = 0;
+
+        uint64_t before = walked(SLL_OP_DEDUP);
+        int removed = fuzz_model_dedup(&model, equal, NULL, released.expected);
+        FUZZ_CHECK(sll_dedup_linked_list(list, equal, collect, &released) == removed);
+        FUZZ_CHECK(released.count == removed);
+        for (int i = 0; i < removed; ++i) {
+            FUZZ_CHECK(released.items[i] == released.expected[i]);
+        }
+        CHECK_WALK(SLL_OP_DEDUP, before, length);
+        break;
+    }
+    default:
+        break;
+    }
+
+    check_length();
+}
+
+static void fill(void *ctx, long n) {
+    sll_t **sll = ctx;
+    *sll = sll_create_linked_list();
+    for (long i = 0; i < n; ++i) {
+        sll_add_head_node(*sll, (void *)(intptr_t) (i + 1));
+    }
+}
+
+static void clear(void *ctx, long n) {
+    (void)n;
+    sll_destroy_linked_list(*(sll_t **) ctx);
+}
+
+static void run_head(void *ctx, long n) {
+    sll_t *sll = *(sll_t **) ctx;
+    for (long i = 0; i < n; ++i) {
+        sll_add_head_node(sll, (void *)1);
+        sll_delete_head_node(sll);
+    }
+}
+
+static void run_tail(void *ctx, long n) {
+    sll_t *sll = *(sll_t **) ctx;
+    for (long i = 0; i < n; ++i) {
+        sll_add_tail_node(sll, (void *)1);
+        sll_delete_head_node(sll);
+    }
+}
+
+static void run_pos_head(void *ctx, long n) {
+    sll_t *sll = *(sll_t **) ctx;
+    for (long i = 0; i < n; ++i) {
+        sll_insert_node(sll, 0, (void *)1);
+        sll_delete_node(sll, 0);
+    }
+}
+
+static void run_second(void *ctx, long n) {
+    sll_t *sll = *(sll_t **) ctx;
+    for (long i = 0; i < n; ++i) {
+        sll_insert_node(sll, 1, (void *)1);
+        sll_delete_node(sll, 1);
+    }
+}
+
+static void run_length(void *ctx, long n) {
+    sll_t *sll = *(sll_t **) ctx;
+    long total = 0;
+    for (long i = 0; i < n; ++i) {
+        total += sll_get_length(sll);
+    }
+    FUZZ_CHECK(total >= n);
+}
+
+int main(int argc, char **argv) {
+    fuzz_config_t config;
+    if (fuzz_parse_args(&config, argc, argv) != 0) {
+        return 1;
+    }
+    if (fuzz_model_init(&model, config.max_size + MAX_BATCH) != 0) {
+        return 1;
+    }
+    released.items = (void **) malloc(model.capacity * sizeof(void *));
+    released.expected = (void **) malloc(model.capacity * sizeof(void *));
+    if (released.items == NULL || released.expected == NULL) {
+        return 1;
+    }
+
+    printf("Replaying %ld operations with seed %llu...\n", config.ops, (unsigned long long) config.seed);
+    list = sll_create_linked_list();
+    for (long i = 0; i < config.ops; ++i) {
+        fuzz_set_step(i);
+        step((fuzz_op_t) fuzz_random(FUZZ_OP_COUNT), config.max_size);
+        if (i % CHECK_INTERVAL == 0) {
+            check_list();
+        }
+    }
+    check_list();
+    sll_destroy_linked_list(list);
+    fuzz_model_free(&model);
+    free(released.items);
+    free(released.expected);
+    printf("Passed.\n");
+
+    printf("Checking constant time operations...\n");
+    sll_t *sll = NULL;
+    fuzz_check_flat(&config, "sll_add_head_node+sll_delete_head_node", fill, run_head, clear, &sll);
+    fuzz_check_flat(&config, "sll_add_tail_node+sll_delete_head_node", fill, run_tail, clear, &sll);
+    fuzz_check_flat(&config, "sll_insert_node+sll_delete_node at 0", fill, run_pos_head, clear, &sll);
+    fuzz_check_flat(&config, "sll_insert_node+sll_delete_node at 1", fill, run_second, clear, &sll);
+    fuzz_check_flat(&config, "sll_get_length", fill, run_length, clear, &sll);
+    printf("Passed.\n");
+
+    printf("All tests passed successfully.\n");
+    return 0;
+}
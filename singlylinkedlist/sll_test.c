@@ -1,5 +1,6 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
 #include <assert.h>
 #include "singlylinkedlist.h"
 
@@ -8,9 +9,7 @@ void test_create() {
     sll_t *list = sll_create_linked_list();
     assert(list != NULL);
     assert(sll_get_length(list) == 0);
-    // Since we don't have a destroy function, we assume the test environment cleans up 
-    // or we accept the leak for the test duration.
-    free(list); 
+    sll_destroy_linked_list(list);
     printf("Passed.\n");
 }
 
@@ -39,7 +38,7 @@ void test_add_and_delete_head() {
     val = sll_delete_head_node(list);
     assert(val == NULL);
 
-    free(list);
+    sll_destroy_linked_list(list);
     printf("Passed.\n");
 }
 
@@ -67,7 +66,7 @@ void test_add_and_delete_tail() {
     
     assert(sll_delete_tail_node(list) == NULL);
     
-    free(list);
+    sll_destroy_linked_list(list);
     printf("Passed.\n");
 }
 
@@ -106,7 +105,7 @@ void test_insert_and_delete_pos() {
     assert(val == (void *)30);
     assert(sll_get_length(list) == 0);
     
-    free(list);
+    sll_destroy_linked_list(list);
     printf("Passed.\n");
 }
 
@@ -129,7 +128,178 @@ void test_reverse() {
     // Test reversing empty list (should fail per implementation)
     assert(sll_reverse_linked_list(list) == 1);
     
-    free(list);
+    sll_destroy_linked_list(list);
+    printf("Passed.\n");
+}
+
+void test_insert_nodes() {
+    printf("Running test_insert_nodes...\n");
+    sll_t *list = sll_create_linked_list();
+    sll_add_tail_node(list, (void *)10);
+    sll_add_tail_node(list, (void *)20);
+    // [10, 20]
+
+    sll_insert_item_t items[] = {
+        { 0, (void *)1 },  // [1, 10, 20]
+        { 2, (void *)2 },  // [1, 10, 2, 20]
+        { 1, (void *)99 }, // below previous position, fails
+        { 2, (void *)3 },  // [1, 10, 3, 2, 20]
+        { 5, (void *)4 },  // [1, 10, 3, 2, 20, 4]
+        { 9, (void *)99 }, // out of range, fails
+    };
+    int status[6];
+    assert(sll_insert_nodes(list, items, 6, status) == 1);
+    assert(status[0] == 0 && status[1] == 0 && status[2] == 1);
+    assert(status[3] == 0 && status[4] == 0 && status[5] == 1);
+    assert(sll_get_length(list) == 6);
+
+    void *expected[] = { (void *)1, (void *)10, (void *)3, (void *)2, (void *)20, (void *)4 };
+    for (int i = 0; i < 6; ++i) {
+        assert(sll_delete_head_node(list) == expected[i]);
+    }
+
+    // Everything succeeds on an empty list
+    sll_insert_item_t more[] = { { 0, (void *)1 }, { 1, (void *)2 } };
+    assert(sll_insert_nodes(list, more, 2, NULL) == 0);
+    assert(sll_delete_head_node(list) == (void *)1);
+    assert(sll_delete_head_node(list) == (void *)2);
+
+    sll_destroy_linked_list(list);
+    printf("Passed.\n");
+}
+
+void test_delete_nodes() {
+    printf("Running test_delete_nodes...\n");
+    sll_t *list = sll_create_linked_list();
+    for (intptr_t i = 0; i < 6; ++i) {
+        sll_add_tail_node(list, (void *)i);
+    }
+    // [0, 1, 2, 3, 4, 5]
+
+    int positions[] = { 0, 2, 2, 3, 5, 7 };
+    void *data[6];
+    int status[6];
+    assert(sll_delete_nodes(list, positions, 6, data, status) == 1);
+    assert(status[0] == 0 && data[0] == (void *)0);
+    assert(status[1] == 0 && data[1] == (void *)2);
+    assert(status[2] == 1 && data[2] == NULL); // not increasing
+    assert(status[3] == 0 && data[3] == (void *)3);
+    assert(status[4] == 0 && data[4] == (void *)5); // last node
+    assert(status[5] == 1 && data[5] == NULL); // out of range
+    assert(sll_get_length(list) == 2);
+
+    assert(sll_delete_head_node(list) == (void *)1);
+    assert(sll_delete_head_node(list) == (void *)4);
+
+    sll_destroy_linked_list(list);
+    printf("Passed.\n");
+}
+
+void test_append_nodes() {
+    printf("Running test_append_nodes...\n");
+    sll_t *list = sll_create_linked_list();
+    void *data[] = { (void *)1, (void *)2, (void *)3 };
+
+    assert(sll_append_nodes(list, data, 3, NULL) == 0);
+    assert(sll_append_nodes(list, data, 2, NULL) == 0);
+    assert(sll_get_length(list) == 5);
+
+    void *expected[] = { (void *)1, (void *)2, (void *)3, (void *)1, (void *)2 };
+    for (int i = 0; i < 5; ++i) {
+        assert(sll_delete_head_node(list) == expected[i]);
+    }
+
+    sll_destroy_linked_list(list);
+    printf("Passed.\n");
+}
+
+static bool is_even(void *data, void *ctx) {
+    (void)ctx;
+    return (intptr_t) data % 2 == 0;
+}
+
+static void count_release(void *data, void *ctx) {
+    (void)data;
+    (*(int *) ctx)++;
+}
+
+// drains the list and checks it against expected
+static void assert_drain(sll_t *list, const intptr_t *expected, int count) {
+    assert(sll_get_length(list) == count);
+    for (int i = 0; i < count; ++i) {
+        assert(sll_delete_head_node(list) == (void *)expected[i]);
+    }
+    assert(sll_get_length(list) == 0);
+}
+
+void test_rotate() {
+    printf("Running test_rotate...\n");
+    sll_t *list = sll_create_linked_list();
+    assert(sll_rotate_linked_list(list, 0) == 1);
+
+    void *data[] = { (void *)1, (void *)2, (void *)3, (void *)4 };
+    sll_append_nodes(list, data, 4, NULL);
+    assert(sll_rotate_linked_list(list, 4) == 1);
+    assert(sll_rotate_linked_list(list, -1) == 1);
+    assert(sll_rotate_linked_list(list, 0) == 0);
+    assert(sll_rotate_linked_list(list, 1) == 0);
+    // 2 -> 3 -> 4 -> 1
+    assert(sll_rotate_linked_list(list, 3) == 0);
+    // 1 -> 2 -> 3 -> 4
+
+    // The tail moved along, appending still works
+    sll_add_tail_node(list, (void *)5);
+    intptr_t expected[] = { 1, 2, 3, 4, 5 };
+    assert_drain(list, expected, 5);
+
+    sll_destroy_linked_list(list);
+    printf("Passed.\n");
+}
+
+void test_partition() {
+    printf("Running test_partition...\n");
+    sll_t *list = sll_create_linked_list();
+    assert(sll_partition_linked_list(list, is_even, NULL) == 0);
+
+    void *data[] = { (void *)1, (void *)2, (void *)3, (void *)4, (void *)6, (void *)5 };
+    sll_append_nodes(list, data, 6, NULL);
+    assert(sll_partition_linked_list(list, is_even, NULL) == 3);
+
+    sll_add_tail_node(list, (void *)7);
+    intptr_t expected[] = { 2, 4, 6, 1, 3, 5, 7 };
+    assert_drain(list, expected, 7);
+
+    // Every node matching keeps the order and the tail
+    sll_append_nodes(list, data + 1, 1, NULL);
+    assert(sll_partition_linked_list(list, is_even, NULL) == 1);
+    sll_add_tail_node(list, (void *)8);
+    intptr_t matched[] = { 2, 8 };
+    assert_drain(list, matched, 2);
+
+    sll_destroy_linked_list(list);
+    printf("Passed.\n");
+}
+
+void test_dedup() {
+    printf("Running test_dedup...\n");
+    sll_t *list = sll_create_linked_list();
+    assert(sll_dedup_linked_list(list, NULL, NULL, NULL) == 0);
+
+    void *data[] = { (void *)1, (void *)1, (void *)2, (void *)3, (void *)3, (void *)3 };
+    sll_append_nodes(list, data, 6, NULL);
+    int released = 0;
+    assert(sll_dedup_linked_list(list, NULL, count_release, &released) == 3);
+    assert(released == 3);
+
+    la_usage_t usage;
+    sll_memory_usage(list, &usage);
+    assert(usage.nodes == 3);
+
+    sll_add_tail_node(list, (void *)4);
+    intptr_t expected[] = { 1, 2, 3, 4 };
+    assert_drain(list, expected, 4);
+
+    sll_destroy_linked_list(list);
     printf("Passed.\n");
 }
 
@@ -139,6 +309,12 @@ int main(void) {
     test_add_and_delete_tail();
     test_insert_and_delete_pos();
     test_reverse();
+    test_insert_nodes();
+    test_delete_nodes();
+    test_append_nodes();
+    test_rotate();
+    test_partition();
+    test_dedup();
     printf("All tests passed successfully.\n");
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,177 @@
+#include "workstealingdeque.h"
+#include <stdatomic.h>
+#include <stdlib.h>
+
+#define WSD_CACHE_LINE 64
+
+// circular storage, retired arrays are kept until the deque is destroyed
+// since a thief may still be reading from them
+typedef struct WsdArray {
+    int64_t capacity;
+    int64_t mask;
+    struct WsdArray *retired;
+    _Atomic(void *) slots[];
+} wsd_array_t;
+
+// work-stealing deque, top and bottom live on separate cache lines
+typedef struct Wsd {
+    _Alignas(WSD_CACHE_LINE) _Atomic int64_t top;
+    _Alignas(WSD_CACHE_LINE) _Atomic int64_t bottom;
+    _Alignas(WSD_CACHE_LINE) _Atomic(wsd_array_t *) array;
+} wsd_t;
+
+static wsd_array_t *wsd_create_array(int64_t capacity) {
+    wsd_array_t *array = (wsd_array_t *) malloc(sizeof(wsd_array_t) + capacity * sizeof(_Atomic(void *)));
+    if (array == NULL) {
+        return NULL;
+    }
+
+    array->capacity = capacity;
+    array->mask     = capacity - 1;
+    array->retired  = NULL;
+    return array;
+}
+
+static wsd_array_t *wsd_grow_array(wsd_array_t *array, int64_t top, int64_t bottom) {
+    wsd_array_t *new_array = wsd_create_array(array->capacity * 2);
+    if (new_array == NULL) {
+        return NULL;
+    }
+
+    // copy live elements, indices keep their value modulo the new capacity
+    for (int64_t i = top; i < bottom; ++i) {
+        void *data = atomic_load_explicit(&array->slots[i & array->mask], memory_order_relaxed);
+        atomic_store_explicit(&new_array->slots[i & new_array->mask], data, memory_order_relaxed);
+    }
+
+    new_array->retired = array;
+    return new_array;
+}
+
+wsd_t *wsd_create_deque(int capacity) {
+    // round capacity up to a power of two
+    int64_t size = 2;
+    while (size < capacity) {
+        size *= 2;
+    }
+
+    wsd_t *wsd = (wsd_t *) aligned_alloc(WSD_CACHE_LINE, sizeof(wsd_t));
+    if (wsd == NULL) {
+        return NULL;
+    }
+
+    wsd_array_t *array = wsd_create_array(size);
+    if (array == NULL) {
+        free(wsd);
+        return NULL;
+    }
+
+    atomic_init(&wsd->top, 0);
+    atomic_init(&wsd->bottom, 0);
+    atomic_init(&wsd->array, array);
+    return wsd;
+}
+
+void wsd_destroy_deque(wsd_t *wsd) {
+    if (wsd == NULL) {
+        return;
+    }
+
+    wsd_array_t *array = atomic_load_explicit(&wsd->array, memory_order_relaxed);
+    while (array != NULL) {
+        wsd_array_t *tmp = array;
+        array = array->retired;
+        free(tmp);
+    }
+
+    free(wsd);
+}
+
+int wsd_push_bottom(wsd_t *wsd, void *data) {
+    // NULL is reserved for the empty result
+    if (data == NULL) {
+        return 1;
+    }
+
+    int64_t bottom = atomic_load_explicit(&wsd->bottom, memory_order_relaxed);
+    int64_t top = atomic_load_explicit(&wsd->top, memory_order_acquire);
+    wsd_array_t *array = atomic_load_explicit(&wsd->array, memory_order_relaxed);
+
+    // full, grow the circular storage
+    if (bottom - top > array->capacity - 1) {
+        array = wsd_grow_array(array, top, bottom);
+        if (array == NULL) {
+            return 1;
+        }
+        atomic_store_explicit(&wsd->array, array, memory_order_release);
+    }
+
+    atomic_store_explicit(&array->slots[bottom & array->mask], data, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&wsd->bottom, bottom + 1, memory_order_relaxed);
+
+    return 0;
+}
+
+void *wsd_pop_bottom(wsd_t *wsd) {
+    int64_t bottom = atomic_load_explicit(&wsd->bottom, memory_order_relaxed) - 1;
+    wsd_array_t *array = atomic_load_explicit(&wsd->array, memory_order_relaxed);
+    atomic_store_explicit(&wsd->bottom, bottom, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    int64_t top = atomic_load_explicit(&wsd->top, memory_order_relaxed);
+
+    // empty check
+    if (top > bottom) {
+        atomic_store_explicit(&wsd->bottom, bottom + 1, memory_order_relaxed);
+        return NULL;
+    }
+
+    void *data = atomic_load_explicit(&array->slots[bottom & array->mask], memory_order_relaxed);
+
+    // more than one element, no thief can reach this one
+    if (top < bottom) {
+        return data;
+    }
+
+    // last element, race the thieves for it
+    if (!atomic_compare_exchange_strong_explicit(&wsd->top, &top, top + 1,
+                                                 memory_order_seq_cst, memory_order_relaxed)) {
+        data = NULL;
+    }
+    atomic_store_explicit(&wsd->bottom, bottom + 1, memory_order_relaxed);
+
+    return data;
+}
+
+void *wsd_steal(wsd_t *wsd) {
+    for (;;) {
+        int64_t top = atomic_load_explicit(&wsd->top, memory_order_acquire);
+        atomic_thread_fence(memory_order_seq_cst);
+        int64_t bottom = atomic_load_explicit(&wsd->bottom, memory_order_acquire);
+
+        // empty check
+        if (top >= bottom) {
+            return NULL;
+        }
+
+        wsd_array_t *array = atomic_load_explicit(&wsd->array, memory_order_acquire);
+        void *data = atomic_load_explicit(&array->slots[top & array->mask], memory_order_relaxed);
+
+        if (atomic_compare_exchange_strong_explicit(&wsd->top, &top, top + 1,
+                                                    memory_order_seq_cst, memory_order_relaxed)) {
+            return data;
+        }
+
+        // lost the race to another thief or the owner, retry
+    }
+}
+
+int64_t wsd_get_size(wsd_t *wsd) {
+    int64_t bottom = atomic_load_explicit(&wsd->bottom, memory_order_relaxed);
+    int64_t top = atomic_load_explicit(&wsd->top, memory_order_relaxed);
+    return bottom > top ? bottom - top : 0;
+}
+
+int64_t wsd_get_capacity(wsd_t *wsd) {
+    return atomic_load_explicit(&wsd->array, memory_order_relaxed)->capacity;
+}
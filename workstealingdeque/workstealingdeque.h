@@ -0,0 +1,83 @@
+/**
+ * @file workstealingdeque.h
+ * @brief A lock-free Chase-Lev work-stealing deque of generic data.
+ * @note The deque has a single owner thread which pushes and pops at the
+ * bottom, while any number of thief threads may steal from the top
+ * concurrently. The storage is a circular array that grows on demand.
+ * This library stores data using `void*` pointers; `NULL` cannot be stored
+ * since it is used to signal an empty deque. The user is responsible for
+ * managing the memory of the data stored in the deque.
+ */
+#ifndef WORKSTEALINGDEQUE_H
+#define WORKSTEALINGDEQUE_H
+
+#include <stdint.h>
+
+/**
+ * @brief A work-stealing deque structure.
+ * @ingroup WorkStealingDeque
+ */
+typedef struct Wsd wsd_t;
+
+/**
+ * @brief Creates a new, empty work-stealing deque.
+ * @param capacity The initial capacity, rounded up to a power of two.
+ * @return A pointer to the new deque, or NULL on failure.
+ * @ingroup WorkStealingDeque
+ */
+wsd_t *wsd_create_deque(int capacity);
+
+/**
+ * @brief Destroys the deque and releases all of its storage.
+ * @param wsd A pointer to the deque.
+ * @note No other thread may access the deque during or after this call.
+ * @ingroup WorkStealingDeque
+ */
+void wsd_destroy_deque(wsd_t *wsd);
+
+/**
+ * @brief Pushes data onto the bottom of the deque.
+ * @param wsd A pointer to the deque.
+ * @param data The data to push, must not be NULL.
+ * @return 0 on success, 1 on failure.
+ * @note Must only be called by the owner thread.
+ * @ingroup WorkStealingDeque
+ */
+int wsd_push_bottom(wsd_t *wsd, void *data);
+
+/**
+ * @brief Pops data from the bottom of the deque.
+ * @param wsd A pointer to the deque.
+ * @return The most recently pushed data, or NULL if the deque is empty.
+ * @note Must only be called by the owner thread.
+ * @ingroup WorkStealingDeque
+ */
+void *wsd_pop_bottom(wsd_t *wsd);
+
+/**
+ * @brief Steals data from the top of the deque.
+ * @param wsd A pointer to the deque.
+ * @return The oldest data in the deque, or NULL if the deque is empty.
+ * @note May be called by any thread.
+ * @ingroup WorkStealingDeque
+ */
+void *wsd_steal(wsd_t *wsd);
+
+/**
+ * @brief Gets the number of elements in the deque.
+ * @param wsd A pointer to the deque.
+ * @return The number of elements, which is only a snapshot when other
+ * threads are accessing the deque.
+ * @ingroup WorkStealingDeque
+ */
+int64_t wsd_get_size(wsd_t *wsd);
+
+/**
+ * @brief Gets the current capacity of the deque's circular storage.
+ * @param wsd A pointer to the deque.
+ * @return The number of slots in the circular storage.
+ * @ingroup WorkStealingDeque
+ */
+int64_t wsd_get_capacity(wsd_t *wsd);
+
+#endif // WORKSTEALINGDEQUE_H
@@ -0,0 +1,155 @@
+/*
+ * Benchmarks for the work-stealing deque.
+ *
+ * - owner push/pop against the mutex guarded doubly linked list the
+ *   scheduler used before
+ * - fork-join fib on the reference thread pool across thread counts
+ *
+ * usage: wsd_bench [--format=csv|json] [--warmup=N] [--repetitions=N]
+ *                  [--filter=TEXT]
+ */
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "workstealingdeque.h"
+#include "../doublylinkedlist/doublylinkedlist.h"
+#include "../examples/threadpool.h"
+#include "../bench/bench.h"
+
+#define FIB_N 30
+#define FIB_CUTOFF 16
+#define DEQUE_DEPTH 1000L
+
+typedef struct {
+    wsd_t *deque;
+    pthread_mutex_t lock;
+    dll_t *dll;
+    tp_pool_t *pool;
+} wsd_bench_t;
+
+// push then pop, one op is a push/pop pair
+static void run_wsd_push_pop(void *ctx, long ops) {
+    wsd_bench_t *b = ctx;
+    for (intptr_t i = 1; i <= ops; ++i) {
+        wsd_push_bottom(b->deque, (void *)i);
+    }
+    for (long i = 0; i < ops; ++i) {
+        wsd_pop_bottom(b->deque);
+    }
+}
+
+static void run_dll_locked_push_pop(void *ctx, long ops) {
+    wsd_bench_t *b = ctx;
+    for (intptr_t i = 1; i <= ops; ++i) {
+        pthread_mutex_lock(&b->lock);
+        dll_add_begin_node((void *)i, b->dll);
+        pthread_mutex_unlock(&b->lock);
+    }
+    for (long i = 0; i < ops; ++i) {
+        pthread_mutex_lock(&b->lock);
+        dll_delete_begin_node(b->dll);
+        pthread_mutex_unlock(&b->lock);
+    }
+}
+
+typedef struct {
+    tp_task_t task;
+    int n;
+    long result;
+} fib_t;
+
+static long fib_sequential(int n) {
+    return n < 2 ? n : fib_sequential(n - 1) + fib_sequential(n - 2);
+}
+
+static void fib_task(void *arg) {
+    fib_t *fib = (fib_t *) arg;
+    if (fib->n < FIB_CUTOFF) {
+        fib->result = fib_sequential(fib->n);
+        return;
+    }
+
+    fib_t left = { .n = fib->n - 1 };
+    tp_init_task(&left.task, fib_task, &left);
+    tp_spawn(&left.task);
+
+    fib_t right = { .n = fib->n - 2 };
+    fib_task(&right);
+
+    tp_wait(&left.task);
+    fib->result = left.result + right.result;
+}
+
+// number of tasks spawned by fib_task(n)
+static long fib_tasks(int n) {
+    return n < FIB_CUTOFF ? 0 : 1 + fib_tasks(n - 1) + fib_tasks(n - 2);
+}
+
+// one run computes fib(FIB_N), one op is a spawned task
+static void run_fib(void *ctx, long ops) {
+    wsd_bench_t *b = ctx;
+    (void)ops;
+    fib_t root = { .n = FIB_N };
+    tp_init_task(&root.task, fib_task, &root);
+    tp_run(b->pool, &root.task);
+}
+
+int main(int argc, char **argv) {
+    bench_config_t config;
+    if (bench_parse_args(&config, argc, argv) != 0) {
+        return 1;
+    }
+
+    wsd_bench_t b = { 0 };
+    b.deque = wsd_create_deque((int) DEQUE_DEPTH);
+    pthread_mutex_init(&b.lock, NULL);
+    b.dll = dll_create_linked_list();
+    if (b.deque == NULL || b.dll == NULL) {
+        return 1;
+    }
+
+    bench_begin(&config);
+
+    bench_run(&config, "wsd", "wsd_push_pop", "owner", DEQUE_DEPTH, DEQUE_DEPTH,
+              run_wsd_push_pop, NULL, &b);
+    bench_run(&config, "wsd", "dll_locked_push_pop", "owner", DEQUE_DEPTH, DEQUE_DEPTH,
+              run_dll_locked_push_pop, NULL, &b);
+
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    int max_threads = cores > 0 ? (int) cores : 1;
+    long tasks = fib_tasks(FIB_N);
+
+    // powers of two below the core count, then the full core count
+    int thread_counts[32];
+    int runs = 0;
+    for (int threads = 1; threads < max_threads; threads *= 2) {
+        thread_counts[runs++] = threads;
+    }
+    thread_counts[runs++] = max_threads;
+
+    for (int i = 0; i < runs; ++i) {
+        int threads = thread_counts[i];
+        char workload[32];
+        snprintf(workload, sizeof(workload), "%d_threads", threads);
+
+        if (bench_enabled(&config, "wsd", "tp_fork_join_fib", workload)) {
+            b.pool = tp_create_pool(threads);
+            if (b.pool == NULL) {
+                return 1;
+            }
+            bench_run(&config, "wsd", "tp_fork_join_fib", workload, FIB_N, tasks,
+                      run_fib, NULL, &b);
+            tp_destroy_pool(b.pool);
+        }
+    }
+
+    bench_end(&config);
+
+    dll_destroy_linked_list(b.dll);
+    pthread_mutex_destroy(&b.lock);
+    wsd_destroy_deque(b.deque);
+    return 0;
+}
@@ -0,0 +1,159 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <assert.h>
+#include <pthread.h>
+#include "workstealingdeque.h"
+
+void test_create() {
+    printf("Running test_create...\n");
+    wsd_t *deque = wsd_create_deque(5);
+    assert(deque != NULL);
+    assert(wsd_get_size(deque) == 0);
+    assert(wsd_get_capacity(deque) == 8);
+    wsd_destroy_deque(deque);
+    printf("Passed.\n");
+}
+
+void test_push_and_pop_bottom() {
+    printf("Running test_push_and_pop_bottom...\n");
+    wsd_t *deque = wsd_create_deque(4);
+
+    assert(wsd_push_bottom(deque, (void *)10) == 0);
+    assert(wsd_push_bottom(deque, (void *)20) == 0);
+    assert(wsd_get_size(deque) == 2);
+
+    // LIFO at the bottom
+    assert(wsd_pop_bottom(deque) == (void *)20);
+    assert(wsd_pop_bottom(deque) == (void *)10);
+    assert(wsd_get_size(deque) == 0);
+
+    // Pop from empty
+    assert(wsd_pop_bottom(deque) == NULL);
+    assert(wsd_get_size(deque) == 0);
+
+    // NULL is rejected
+    assert(wsd_push_bottom(deque, NULL) == 1);
+
+    wsd_destroy_deque(deque);
+    printf("Passed.\n");
+}
+
+void test_steal() {
+    printf("Running test_steal...\n");
+    wsd_t *deque = wsd_create_deque(4);
+
+    wsd_push_bottom(deque, (void *)1);
+    wsd_push_bottom(deque, (void *)2);
+    wsd_push_bottom(deque, (void *)3);
+
+    // FIFO at the top
+    assert(wsd_steal(deque) == (void *)1);
+    assert(wsd_pop_bottom(deque) == (void *)3);
+    assert(wsd_steal(deque) == (void *)2);
+
+    // Steal from empty
+    assert(wsd_steal(deque) == NULL);
+    assert(wsd_pop_bottom(deque) == NULL);
+
+    wsd_destroy_deque(deque);
+    printf("Passed.\n");
+}
+
+void test_grow() {
+    printf("Running test_grow...\n");
+    wsd_t *deque = wsd_create_deque(2);
+
+    // Advance the indices so the live range wraps around the storage
+    for (intptr_t i = 1; i <= 3; ++i) {
+        wsd_push_bottom(deque, (void *)i);
+        assert(wsd_steal(deque) == (void *)i);
+    }
+
+    for (intptr_t i = 1; i <= 100; ++i) {
+        assert(wsd_push_bottom(deque, (void *)i) == 0);
+    }
+    assert(wsd_get_size(deque) == 100);
+    assert(wsd_get_capacity(deque) == 128);
+
+    for (intptr_t i = 1; i <= 50; ++i) {
+        assert(wsd_steal(deque) == (void *)i);
+    }
+    for (intptr_t i = 100; i > 50; --i) {
+        assert(wsd_pop_bottom(deque) == (void *)i);
+    }
+    assert(wsd_get_size(deque) == 0);
+
+    wsd_destroy_deque(deque);
+    printf("Passed.\n");
+}
+
+#define CONCURRENT_ITEMS 200000
+#define CONCURRENT_THIEVES 3
+
+static wsd_t *shared_deque;
+static atomic_int owner_done;
+static atomic_uchar seen[CONCURRENT_ITEMS + 1];
+static atomic_long taken;
+
+static void record(void *data) {
+    intptr_t value = (intptr_t)data;
+    assert(value >= 1 && value <= CONCURRENT_ITEMS);
+    // every item must be taken exactly once
+    assert(atomic_fetch_add(&seen[value], 1) == 0);
+    atomic_fetch_add(&taken, 1);
+}
+
+static void *thief(void *arg) {
+    (void)arg;
+    while (!atomic_load(&owner_done) || wsd_get_size(shared_deque) > 0) {
+        void *data = wsd_steal(shared_deque);
+        if (data != NULL) {
+            record(data);
+        }
+    }
+    return NULL;
+}
+
+void test_concurrent_steal() {
+    printf("Running test_concurrent_steal...\n");
+    shared_deque = wsd_create_deque(4);
+    atomic_store(&owner_done, 0);
+
+    pthread_t thieves[CONCURRENT_THIEVES];
+    for (int i = 0; i < CONCURRENT_THIEVES; ++i) {
+        assert(pthread_create(&thieves[i], NULL, thief, NULL) == 0);
+    }
+
+    // Owner interleaves pushes and pops while the thieves steal
+    for (intptr_t i = 1; i <= CONCURRENT_ITEMS; ++i) {
+        assert(wsd_push_bottom(shared_deque, (void *)i) == 0);
+        if (i % 3 == 0) {
+            void *data = wsd_pop_bottom(shared_deque);
+            if (data != NULL) {
+                record(data);
+            }
+        }
+    }
+    atomic_store(&owner_done, 1);
+
+    for (int i = 0; i < CONCURRENT_THIEVES; ++i) {
+        pthread_join(thieves[i], NULL);
+    }
+
+    assert(atomic_load(&taken) == CONCURRENT_ITEMS);
+
+    wsd_destroy_deque(shared_deque);
+    printf("Passed.\n");
+}
+
+int main(void) {
+    test_create();
+    test_push_and_pop_bottom();
+    test_steal();
+    test_grow();
+    test_concurrent_steal();
+    printf("All tests passed successfully.\n");
+    return 0;
+}